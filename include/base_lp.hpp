@@ -19,6 +19,8 @@
 
 #include <limits>
 #include <memory>
+#include <span>
+#include <vector>
 #include <gurobi_c++.h>
 
 #include "config_parameters.hpp"
@@ -61,6 +63,47 @@ public:
 
     GRBConstr getConstrByName(const std::string& name);
 
+    /**
+     * @brief Dual values (Pi) of the given constraints by a single array
+     * attribute query.
+     */
+    std::vector<double> getDuals(std::span<const GRBConstr> constrs);
+
+    /**
+     * @brief Values of a double attribute (the solution value by default) of
+     * the given variables by a single array attribute query.
+     */
+    std::vector<double> getValues(std::span<const GRBVar> vars,
+                                  GRB_DoubleAttr attr = GRB_DoubleAttr_X);
+
+    /**
+     * @brief Values of an int attribute (e.g., VBasis) of the given variables
+     * by a single array attribute query.
+     */
+    std::vector<int> getValues(std::span<const GRBVar> vars,
+                               GRB_IntAttr attr);
+
+    /**
+     * @brief Values of a double attribute (e.g., Slack) of the given
+     * constraints by a single array attribute query.
+     */
+    std::vector<double> getValues(std::span<const GRBConstr> constrs,
+                                  GRB_DoubleAttr attr);
+
+    /**
+     * @brief Sets the objective coefficients of the given variables by a
+     * single array attribute call.
+     */
+    void setObj(std::span<const GRBVar> vars, std::span<const double> vals);
+
+    /**
+     * @brief Sets a double attribute (e.g., UB) of the given variables by a
+     * single array attribute call.
+     */
+    void setValues(std::span<const GRBVar> vars,
+                   std::span<const double> vals,
+                   GRB_DoubleAttr attr);
+
     GRBEnv& getGRBEnv();
     GRBModel& getGRBModel();
 
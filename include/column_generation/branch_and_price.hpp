@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: branch_and_price.hpp
+ *
+ * @brief Branch-and-price algorithm class declaration. The linear relaxation
+ * of each node is solved by column generation (Cg) and the fractional
+ * solutions are branched by the Ryan-Foster rule [1] on the pair of customers
+ * whose (fractional) number of routes visiting both is closest to 0.5 (or on
+ * the edge whose flow is closest to 0.5 when no pair is fractional). The
+ * open nodes are explored in best-bound order by a pool of threads, each node
+ * with its own RMP and pricing model. A node is only pruned as infeasible or
+ * closed as integer if its CG converged; otherwise the run is not proven
+ * optimal. The CG of each node stops at the time limit of the B&P.
+ *
+ * Created on October 17, 2026, 05:30 PM
+ *
+ * References:
+ * [1] D. M. Ryan and B. A. Foster. An integer programming approach to
+ * scheduling. Computer Scheduling of Public Transport: Urban Passenger Vehicle
+ * and Crew Scheduling, 269-280, 1981.
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BRANCH_AND_PRICE_HPP
+#define BRANCH_AND_PRICE_HPP
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "../config_parameters.hpp"
+#include "branching_constr.hpp"
+#include "column.hpp"
+
+class Instance;
+
+namespace utils
+{
+class Stopwatch;
+}
+
+class BranchAndPrice
+{
+public:
+
+    BranchAndPrice() = delete;
+    BranchAndPrice(const BranchAndPrice& other) = delete;
+    BranchAndPrice(BranchAndPrice&& other) = delete;
+    ~BranchAndPrice() = default;
+    BranchAndPrice& operator=(const BranchAndPrice& other) = delete;
+    BranchAndPrice& operator=(BranchAndPrice&& other) = delete;
+
+    BranchAndPrice(const ConfigParameters::cg& cgParams,
+                   const ConfigParameters::bp& bpParams,
+                   const std::vector<Column>& initialColumns,
+                   const std::shared_ptr<const Instance>& pInst);
+
+    /**
+     * @brief Solves the CVRP up to optimality (or up to the time limit).
+     * @return [bool]: true if the optimality was proven.
+     */
+    bool execute(const ConfigParameters::solver& solverParams);
+
+    double getLowerBound() const;
+
+    double getUpperBound() const;
+
+    /**
+     * @brief Routes of the best solution found.
+     */
+    const std::vector<Column>& getSolution() const;
+
+private:
+
+    struct Node
+    {
+        std::vector<BranchingConstr> branching_; // constraints from the root
+        std::vector<Column> columns_; // initial columns (of the parent)
+        double lb_;                   // lower bound (of the parent)
+        int depth_;
+    };
+
+    ConfigParameters::cg mCgParams;
+    ConfigParameters::bp mBpParams;
+
+    // pointer to instance
+    std::shared_ptr<const Instance> mpInst;
+
+    // the fields below are guarded by mMutex
+    mutable std::mutex mMutex;
+    std::condition_variable mCv;
+
+    // open nodes (heap by lower bound)
+    std::vector<Node> mOpenNodes;
+    // lower bounds of the nodes being solved
+    std::multiset<double> mActiveLbs;
+    // true if the time limit was reached
+    bool mStop;
+    // least lower bound of the nodes closed without proof (CG not converged)
+    double mUnprovenLb;
+    // # of nodes solved
+    int mNbNodes;
+
+    // best solution found
+    double mUb;
+    std::vector<Column> mSolution;
+    // global lower bound
+    double mLb;
+
+    /**
+     * @brief Solves open nodes until the tree is explored or the time limit
+     * is reached (executed by each thread of the pool).
+     */
+    void runWorker(const ConfigParameters::solver& solverParams,
+                   const utils::Stopwatch& stopwatch);
+
+    /**
+     * @brief Solves the node by CG and branches it if its solution is
+     * fractional and its lower bound is smaller than the upper bound.
+     * @param [double]: time left (seconds) of the B&P.
+     * @return [std::vector<Node>]: children nodes.
+     */
+    std::vector<Node> processNode(const Node& node,
+                                  const ConfigParameters::solver& solverParams,
+                                  const double timeLeft);
+
+    /**
+     * @brief Records a node closed without proof: the B&P can not prove
+     * optimality unless its lower bound reaches the upper bound.
+     */
+    void closeUnproven(const double lb, const char* reason);
+
+    /**
+     * @brief Updates the best solution if the given one is better.
+     */
+    void updateIncumbent(const double cost, const std::vector<Column>& routes);
+
+    /**
+     * @brief Current global lower bound: the least bound among the open, the
+     * active and the unproven nodes (mMutex must be locked).
+     */
+    double computeLowerBound() const;
+};
+
+#endif // BRANCH_AND_PRICE_HPP
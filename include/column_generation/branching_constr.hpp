@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: branching_constr.hpp
+ *
+ * @brief Ryan-Foster branching constraint [1] of the branch-and-price. For a
+ * pair of customers (i, j), either every route visits both or none of them
+ * (together) or no route visits both (separate). The fractional solutions
+ * without a fractional pair are branched on an edge (i, j) (i may be the
+ * depot) instead: either every route visiting i or j uses the edge (together)
+ * or no route uses it (separate).
+ *
+ * Created on October 17, 2026, 05:10 PM
+ *
+ * References:
+ * [1] D. M. Ryan and B. A. Foster. An integer programming approach to
+ * scheduling. Computer Scheduling of Public Transport: Urban Passenger Vehicle
+ * and Crew Scheduling, 269-280, 1981.
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BRANCHING_CONSTR_HPP
+#define BRANCHING_CONSTR_HPP
+
+struct BranchingConstr
+{
+    int i_;
+    int j_;
+    bool together_; // true: i and j in the same route, false: in different
+    bool edge_ = false; // constraint on the edge (i, j), i < j
+};
+
+#endif // BRANCHING_CONSTR_HPP
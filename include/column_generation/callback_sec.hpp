@@ -4,7 +4,28 @@
  * Author: Guilherme O. Chagas
  *
  * @brief Callback class declaration for lazy/cut subtour separation
- * constraints.
+ * constraints. The separation runs a pipeline of cut families, each with its
+ * own limit of sets per call and violation threshold: the connected components
+ * of the support graph (exact at integer solutions, so the only family used
+ * for the lazy constraints), at fractional nodes where no component cut is
+ * violated, the capacity cuts heuristics of CVRPSEP and, as a fallback when
+ * they find nothing, the exact separation by minimum cuts. The values of the
+ * vars are fetched by one call per solution and the buffers of the separation
+ * are kept across the calls. Still, each call allocates: the value arrays
+ * returned by GUROBI (getSolution/getNodeRel) and the expressions of the
+ * constraints added (the GRBLinExpr terms and the GRBTempConstr copies); the
+ * C++ API gives no way to fill caller buffers. The CVRPSEP old cuts are kept
+ * along the life of the callback and the SECs of a set are only added once
+ * per optimization as cuts (the lazy constraints are added whenever they are
+ * violated). The cuts
+ * are selected by violation: a few SECs per set, a limit per call and per
+ * node and a greater violation threshold out of the root node. A scheduler
+ * chooses the nodes separated (all, root, every k-th or the first ones
+ * explored) and stops the separation of a node when its relaxation tails off.
+ * The nodes are identified by the GUROBI node count (it does not give their
+ * depth), which is only reliable if the B&B runs on a single thread: with
+ * more threads the callbacks of different nodes interleave. So the model must
+ * run on one thread if the callback keeps state per node (see keepsNodeState).
  *
  * (I'm sorry for my bad english xD)
  *
@@ -18,11 +39,19 @@
 #define CALLBACK_SEC_HPP
 
 #include <memory>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <gurobi_c++.h>
 
+#include "../config_parameters.hpp"
 #include "../instance.hpp"
 #include "../utils/multi_vector.hpp"
+#include "../utils/tools.hpp"
+#include "capacity_separation.hpp"
+#include "min_cut_separation.hpp"
 
 class CallbackSEC : public GRBCallback
 {
@@ -30,6 +59,14 @@ public:
 
     enum class constrsType {lazy, cut};
 
+    // cuts separation statistics of the nodes of a node count bucket
+    struct NodeCountStats
+    {
+        int nbRounds_;      // # of separation rounds
+        int nbCuts_;        // # of cuts added
+        double gain_;       // increase of the node relaxations by the cuts
+    };
+
     CallbackSEC(const CallbackSEC& other) = default;
     CallbackSEC(CallbackSEC&& other) = default;
     ~CallbackSEC() = default;
@@ -38,36 +75,145 @@ public:
     CallbackSEC& operator=(const CallbackSEC& other) = delete;
     CallbackSEC& operator=(CallbackSEC&& other) = delete;
 
-    CallbackSEC(const utils::Vec2D<GRBVar>& x,
+    CallbackSEC(const ConfigParameters::cg& params,
+                const utils::Vec2D<GRBVar>& x,
                 const std::vector<GRBVar> & y,
                 const std::shared_ptr<const Instance>& p_inst);
 
+    /**
+     * @brief Sets of customers of the capacity cuts separated since the last
+     * call (each set sorted).
+     */
+    std::vector<std::vector<int>> extractSeparatedSets();
+
+    /**
+     * @brief Separation statistics of the last optimization by node count:
+     * the b-th bucket has the nodes with count in [2^b - 1, 2^(b+1) - 1).
+     */
+    const std::vector<NodeCountStats>& getNodeCountStats() const;
+
+    /**
+     * @brief Checks if the separation keeps state per node: the cuts budget of
+     * the node and the tailing off detection (and the gain statistics). The
+     * model must run on a single thread to identify the nodes.
+     */
+    bool keepsNodeState() const;
+
+    /**
+     * @brief Prepares the callback for an optimization: collects the x vars
+     * of the edges in the model and the objective coefficients and forgets
+     * the sets added by the previous one. It must be called before each
+     * optimization, after the model update.
+     */
+    void initOptimization();
+
 private:
 
+    ConfigParameters::cg mParams;
+
     const utils::Vec2D<GRBVar>& mr_x;
     const std::vector<GRBVar> & mr_y;
 
     std::shared_ptr<const Instance> mpInst;
 
+    // x vars of the edges in the model and their end points (i < j)
+    std::vector<GRBVar> mEdgeVars;
+    std::vector<std::pair<int, int>> mEdges;
+    // objective coefficients of the x vars of the edges and of the y vars
+    std::vector<double> mEdgeObj;
+    std::vector<double> mYObj;
+
+    // workspaces reused by every call: values of the vars at the current
+    // solution, component of each vertex, the CVRPSEP buffers and the
+    // max-flow network
+    utils::Vec2D<double> mXVal;
+    std::vector<double> mYVal;
+    std::vector<int> mCompOf;
+    capSep::Workspace mCapSepWs;
+    minCutSep::Workspace mMinCutSepWs;
+    // buffers of the pipeline (cleared, never freed): the sets separated by a
+    // family, the components and the violated ones, the candidate SECs, the
+    // customers of a set by y_i and the lhs of the sets (GUROBI may still
+    // allocate the terms of a cleared expression)
+    utils::Vec2D<int> mSets;
+    utils::Vec2D<int> mComponents;
+    std::vector<std::pair<double, int>> mViolated;
+    std::vector<std::tuple<double, int, int>> mCandidates;
+    std::vector<int> mOrder;
+    std::vector<GRBLinExpr> mLhs;
+    std::vector<bool> mIsUsed;
+
+    // sets of the capacity cuts separated since the last extraction
+    std::vector<std::vector<int>> mSeparatedSets;
+    // sets whose SECs were added in the current optimization
+    std::unordered_set<std::vector<int>, utils::tools::VectorHash> mAddedSets;
+
+    // node of the last cut separation, # of cuts added at it, its last
+    // relaxation value and # of consecutive rounds without gain
+    double mNode;
+    int mNbNodeCuts;
+    double mNodeObj;
+    int mNbTailingRounds;
+    std::vector<NodeCountStats> mNodeCountStats;
+
     void callback() override;
 
-    int addCVRPSEPCAP(const constrsType cstType);
+    /**
+     * @brief Runs the separation pipeline at the current solution (lazy) or
+     * node relaxation (cut).
+     * @return [int]: number of constraints added.
+     */
+    int separate(const constrsType cstType);
 
     /**
-     * @brief Retrieve the x variables values from the relaxation solution at
-     * the current node.
-     * @param: constraint type.
-     * @return: x variables values at the current node.
-    */
-    utils::Vec2D<double> getxVarsValues(const constrsType cstType);
+     * @brief Checks if the cuts are separated at the node by the policy.
+     */
+    bool isScheduled(const double node) const;
+
+    /**
+     * @brief Value of the objective at the current x and y values.
+     */
+    double getObjValue() const;
+
+    /**
+     * @brief Adds the SECs x(E(S)) <= y(S) - y_i of the sets. The lazy
+     * constraints are the SEC of the greatest y_i of each set. The cuts are
+     * the (at most cg_sep_secs_per_set) most violated SECs of each set not yet
+     * added, ranked by violation over all the sets and violated by more than
+     * the given threshold.
+     * @param [utils::Vec2D<int>]: sets (only the first nbSets are used).
+     * @param [int]: maximum number of cuts (ignored by the lazy constraints).
+     * @return [int]: number of constraints added.
+     */
+    int addSecs(const utils::Vec2D<int>& sets,
+                const int nbSets,
+                const utils::Vec2D<double>& xVal,
+                const std::vector<double>& yVal,
+                const double minViolation,
+                const int maxNbCuts,
+                const constrsType cstType);
+
+    /**
+     * @brief Connected components of the customers in the support graph
+     * (without the depot) whose SEC x(E(S)) <= y(S) - max_i y_i is violated by
+     * more than the given threshold, the most violated first.
+     * @param [int]: maximum number of components.
+     * @param [utils::Vec2D<int>&]: sorted sets of customers, written to its
+     * first entries (the others are buffers kept for the next calls).
+     * @return [int]: number of sets.
+     */
+    int separateComponents(const utils::Vec2D<double>& xVal,
+                           const std::vector<double>& yVal,
+                           const int maxNbSets,
+                           const double minViolation,
+                           utils::Vec2D<int>& sets);
 
     /**
-     * @brief Retrieve the y variables values from the relaxation solution at
-     * the current node.
+     * @brief Retrieve the x and y variables values from the solution (lazy)
+     * or from the relaxation solution at the current node (cut).
      * @param: constraint type.
-     * @return: y variables values at the current node.
     */
-    std::vector<double> getyVarsValues(const constrsType cstType);
+    void updateValues(const constrsType cstType);
 };
 
 #endif // CALLBACK_SEC_HPP
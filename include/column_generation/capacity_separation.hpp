@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: capacity_separation.hpp
+ *
+ * @brief Rounded capacity cuts separation functions declarations. The cuts
+ * x(delta(S)) >= 2 ceil(d(S) / C) of a set S of customers are separated by
+ * the CVRPSEP package [1] at given (fractional) edge values. They are used by
+ * the PCTSP pricing callback (CallbackSEC) and by the RMP (SetCoveringLp).
+ *
+ * Created on October 17, 2026, 08:40 PM
+ *
+ * References:
+ * [1] J. Lysgaard, A. N. Letchford, and R. W. Eglese. A new branch-and-cut
+ * algorithm for the capacitated vehicle routing problem. Mathematical
+ * Programming, 100(2):423-445, 2004.
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CAPACITY_SEPARATION_HPP
+#define CAPACITY_SEPARATION_HPP
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "../ext/cvrpsep/cnstrmgr.h"
+#include "../utils/multi_vector.hpp"
+#include "../utils/tools.hpp"
+
+class Instance;
+
+namespace capSep
+{
+
+/**
+ * @brief Buffers of the separation reused across calls (e.g., by a callback):
+ * the demands, the edges in the CVRPSEP format and the constraint managers.
+ * The cuts separated by each call are kept (once) as old cuts of the next
+ * calls: CVRPSEP uses them as seeds and does not return them again. A
+ * workspace must not be used by concurrent calls.
+ */
+struct Workspace
+{
+    Workspace(const std::shared_ptr<const Instance>& pInst);
+    Workspace(const Workspace& other) = delete;
+    ~Workspace();
+    Workspace& operator=(const Workspace& other) = delete;
+
+    std::shared_ptr<const Instance> pInst_;
+    std::vector<double> demands_;   // demand of each vertex (depot: 0)
+    std::vector<int> edgeTail_;     // edges with positive value (1-based)
+    std::vector<int> edgeHead_;
+    std::vector<double> edgeX_;
+    CnstrMgrPointer cutsCMP_;       // cuts separated by the last call
+    CnstrMgrPointer oldCutsCMP_;    // cuts separated before
+    // sets of the old cuts (CVRPSEP indexes)
+    std::unordered_set<std::vector<int>, utils::tools::VectorHash> oldSets_;
+    std::vector<int> list_;         // set of a cut (CVRPSEP indexes)
+};
+
+/**
+ * @brief Separates rounded capacity cuts. CVRPSEP keeps global state (e.g.,
+ * its sorting stacks), so the calls of the models solved in parallel are
+ * serialized.
+ * @param [utils::Vec2D<double>]: edge values (xVal[i][j], i < j, where 0 is
+ * the depot).
+ * @param [int]: maximum number of cuts.
+ * @param [std::shared_ptr<const Instance>]: pointer to instance.
+ * @return [std::vector<std::vector<int>>]: sorted sets of customers of the
+ * violated cuts.
+ */
+std::vector<std::vector<int>> separateCapacityCuts(
+    const utils::Vec2D<double>& xVal,
+    const int maxNbCuts,
+    const std::shared_ptr<const Instance>& pInst);
+
+/**
+ * @brief Separates rounded capacity cuts with the buffers of the given
+ * workspace. The buffers (and the ones of the sets) grow with the largest call
+ * and are reused, so only the new old cuts allocate memory.
+ * @param [utils::Vec2D<int>&]: sorted sets of customers of the violated cuts,
+ * written to its first entries (the others are buffers kept for the next
+ * calls).
+ * @return [int]: number of sets.
+ */
+int separateCapacityCuts(const utils::Vec2D<double>& xVal,
+                         const int maxNbCuts,
+                         Workspace& ws,
+                         utils::Vec2D<int>& sets);
+
+/**
+ * @brief Least number of vehicles that serve the set of customers:
+ * ceil(d(S) / C).
+ */
+int getMinNbVehicles(const std::vector<int>& set,
+                     const std::shared_ptr<const Instance>& pInst);
+
+} // capSep namespace
+
+#endif // CAPACITY_SEPARATION_HPP
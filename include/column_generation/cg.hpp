@@ -4,7 +4,17 @@
  *
  * @brief Column generation algorithm class declaration. This algorithm follows
  * the idea described at chaper 4 of [1]. It is used the approach of [2] to
- * generate new columns.
+ * generate new columns. The dual values may be stabilized by the Wentges
+ * smoothing with automatic smoothing factor of [3]. At each iteration the
+ * Lagrangian and the Farley [4] lower bounds are computed and the algorithm
+ * stops when the gap between the RMP value and the best lower bound is small.
+ * It solves the linear relaxation of a branch-and-price node: the columns must
+ * satisfy the node branching constraints. When CG converges, the rounded
+ * capacity cuts violated by its solution are added to the RMP and CG resumes
+ * (their duals are priced as edge costs). When no capacity cut is violated,
+ * the subset-row cuts on triples of customers [5] are separated instead. Optionally, several pricing workers
+ * (with their own solver environments) are solved in parallel at randomly
+ * perturbed prizes to generate more columns per iteration.
  *
  * Created on April 18, 2022, 11:12 PM
  * 
@@ -15,6 +25,14 @@
  * collecting traveling salesman problem. Working paper, Department of
  * Industrial Engineering and Engineering Management, Northwestern University,
  * Evanston, IL, 1997.
+ * [3] A. Pessoa, R. Sadykov, E. Uchoa, and F. Vanderbeck. Automation and
+ * combination of linear-programming based stabilization techniques in column
+ * generation. INFORMS Journal on Computing, 30(2):339-360, 2018.
+ * [4] A. A. Farley. A note on bounding a class of linear programming problems,
+ * including cutting stock problems. Operations Research, 38(5):922-923, 1990.
+ * [5] M. Jepsen, B. Petersen, S. Spoorendonk, and D. Pisinger. Subset-row
+ * inequalities applied to the vehicle-routing problem with time windows.
+ * Operations Research, 56(2):497-511, 2008.
  */
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -22,13 +40,17 @@
 #define CG_HPP
 
 #include <memory>
+#include <random>
 #include <vector>
 
 #include "../config_parameters.hpp"
+#include "../utils/multi_vector.hpp"
+#include "branching_constr.hpp"
+#include "subset_row_cut.hpp"
 
 class Column;
 class Instance;
-class PctspIlp;
+class Pricing;
 class SetCoveringLp;
 
 class Cg
@@ -42,32 +64,201 @@ public:
     Cg& operator=(const Cg& other) = default;
     Cg& operator=(Cg&& other) = default;
 
+    /**
+     * @brief Constructor.
+     * @param [ConfigParameters::cg]: CG parameters.
+     * @param [std::vector<Column>]: initial columns of the RMP (they must
+     * satisfy the branching constraints).
+     * @param [std::vector<BranchingConstr>]: branching constraints of the
+     * branch-and-price node (empty at the root node).
+     * @param [std::shared_ptr<const Instance>]: pointer to instance.
+     */
     Cg(const ConfigParameters::cg& params,
        const std::vector<Column>& initialColumns,
+       const std::vector<BranchingConstr>& branching,
        const std::shared_ptr<const Instance>& pInst);
 
+    /**
+     * @brief Solves the linear relaxation by column generation.
+     * @return [bool]: false if the RMP could not be solved.
+     */
     bool execute(const ConfigParameters::solver& solverParams);
 
+    /**
+     * @brief Checks if the last RMP solution is proven optimal for the linear
+     * relaxation (with the cuts added): the last pricing at its duals proved
+     * that no column with negative reduced cost exists or the lower bound
+     * reached its value. CG may stop without convergence (e.g., by the
+     * iterations or the time limit, or by the gap tolerance).
+     */
+    bool isConverged() const;
+
+    /**
+     * @brief Best lower bound (Lagrangian/Farley) on the linear relaxation.
+     */
+    double getLowerBound() const;
+
+    /**
+     * @brief Value of the last RMP solution.
+     */
+    double getObjVal() const;
+
+    /**
+     * @brief Columns with positive value in the last RMP solution.
+     */
+    std::vector<std::pair<Column, double>> getSolution() const;
+
+    /**
+     * @brief All the columns generated (the initial ones included).
+     */
+    std::vector<Column> getColumns() const;
+
+    /**
+     * @brief Checks if the last RMP solution does not use the artificial
+     * variable.
+     */
+    bool isFeasible() const;
+
+    /**
+     * @brief Imposes integrality on the y vars of all the columns generated
+     * and solves the restricted main problem. The RMP can not be used for CG
+     * anymore.
+     * @param [std::vector<Column>&]: routes of the best solution found.
+     * @return [double]: value of the best solution found, +infinity if none.
+     */
+    double solveRestrictedMip(const ConfigParameters::solver& solverParams,
+                              std::vector<Column>& solution);
+
 private:
 
     ConfigParameters::cg mParams;
 
+    // branching constraints of the node
+    std::vector<BranchingConstr> mBranching;
+
     // restricted main problem (RMP)
     std::shared_ptr<SetCoveringLp> mpRMP;
-    // subproblem
-    std::shared_ptr<PctspIlp> mpSubproblem;
+    // subproblem (exact pricing engine)
+    std::shared_ptr<Pricing> mpSubproblem;
+    // additional pricing engines solved in parallel at perturbed prizes
+    std::vector<std::shared_ptr<Pricing>> mWorkers;
+    // random generator of the perturbations of each worker
+    std::vector<std::mt19937> mWorkerRngs;
     // pointer to instance
     std::shared_ptr<const Instance> mpInst;
 
+    // stability center: dual values with the best Lagrangian bound so far
+    std::vector<double> mStabCenter;
+    // Lagrangian bound at the stability center
+    double mStabCenterBound;
+    // current smoothing factor
+    double mAlpha;
+
+    // best lower bound found so far
+    double mLb;
+    // true if the last pricing at the RMP duals proved that no column exists
+    bool mConverged;
+    // lower bound on the cost of any column (used by the Farley bound)
+    double mMinColCost;
+
     /**
-     * @brief Generate a new column by solving the subproblem and add it to the
-     * RMP if the column has negative reduced cost. A TSP-like model [2] is
-     * solved to generate the new column.
+     * @brief Lagrangian bound at the given dual values: the dual objective
+     * plus K times the least reduced cost.
+     * @param [std::vector<double>]: dual values.
+     * @param [double]: lower bound on the least reduced cost at these duals.
+     * @return [double]: Lagrangian bound.
+     */
+    double computeLagrangianBound(const std::vector<double>& duals,
+                                  const double rcBound) const;
+
+    /**
+     * @brief Farley bound [4] at the given dual values: the dual objective
+     * divided by 1 - rc / c, where rc is a lower bound on the least reduced
+     * cost and c a lower bound on the cost of any column.
+     * @param [std::vector<double>]: dual values.
+     * @param [double]: lower bound on the least reduced cost at these duals.
+     * @return [double]: Farley bound.
+     */
+    double computeFarleyBound(const std::vector<double>& duals,
+                              const double rcBound) const;
+
+    /**
+     * @brief Dual objective value: sum of the covering duals plus K times the
+     * k-routes dual plus the right-hand sides times the duals of the cuts.
+     */
+    double computeDualObj(const std::vector<double>& duals) const;
+
+    /**
+     * @brief Updates the best lower bound with the Lagrangian and the Farley
+     * bounds at the given dual values.
+     * @return [double]: Lagrangian bound at the given dual values.
+     */
+    double updateLowerBound(const std::vector<double>& duals,
+                            const double rcBound);
+
+    /**
+     * @brief Generate new columns by solving the subproblem and add to the RMP
+     * the (at most cg_max_nb_cols_per_iter) best distinct columns with negative
+     * reduced cost found. If enabled, a greedy insertion heuristic is tried
+     * first and a TSP-like model [2] is solved only when it fails. Before
+     * pricing, the long unused columns are purged from the RMP and the purged
+     * ones with negative reduced cost are added back instead.
      * 
-     * @return [bool]: true if a new generate column was added to the RMP. False
-     * otherwise.
+     * @return [bool]: true if at least one new column was added to the RMP.
+     * False otherwise.
+     */
+    bool generateColumns();
+
+    /**
+     * @brief Dual values of the RMP constraints: the covering constraints (one
+     * for each vertex) followed by the k-routes constraint.
+     */
+    std::vector<double> getDuals() const;
+
+    /**
+     * @brief Solves the pricing problem (heuristic and/or exact) at the given
+     * dual values. The workers are solved concurrently with the exact pricing
+     * and their columns with negative reduced cost are merged (their bounds
+     * are not valid, as their prizes are perturbed). The tours of the columns
+     * found are improved by local search. The exact pricing is skipped if the
+     * pricing bound proves that no column with negative reduced cost exists.
+     * @param [std::vector<double>]: dual values.
+     * @param [double&]: lower bound on the least reduced cost at these duals,
+     * -infinity if only the heuristic was run.
+     * @return [std::vector<std::pair<Column, double>>]: columns with negative
+     * reduced cost (at the given duals) and their reduced costs.
+     */
+    std::vector<std::pair<Column, double>> price(
+        const std::vector<double>& duals,
+        double& rcBound);
+
+    /**
+     * @brief Solves the w-th worker at the given dual values with the prizes
+     * of the customers randomly perturbed.
+     * @return [std::vector<Column>]: columns found by the worker.
+     */
+    std::vector<Column> runWorker(const int w,
+                                  const std::vector<double>& duals,
+                                  const utils::Vec2D<double>& edgeDuals,
+                                  const std::vector<SubsetRowCut>& srCuts,
+                                  const std::vector<Column>& startColumns);
+
+    /**
+     * @brief Separates the cuts violated by the last RMP solution: the
+     * capacity cuts and, if none is violated, the subset-row cuts. The duals
+     * of the new cuts at the stability center are 0.
+     * @return [int]: number of cuts added to the RMP.
+     */
+    int addCuts();
+
+    /**
+     * @brief Automatic smoothing factor update [3]: alpha decreases if the
+     * subgradient at the separation point (given by the best priced column)
+     * points towards the RMP duals and increases otherwise.
      */
-    bool generateColumn();
+    void updateSmoothingFactor(const Column& column,
+                               const std::vector<double>& sepDuals,
+                               const std::vector<double>& outDuals);
 };
 
 #endif // CG_HPP
@@ -16,9 +16,13 @@
 #ifndef COLUMN_HPP
 #define COLUMN_HPP
 
+#include <array>
 #include <memory>
 #include <vector>
 
+#include "../utils/multi_vector.hpp"
+#include "branching_constr.hpp"
+
 class Instance;
 
 class Column
@@ -43,16 +47,60 @@ public:
     double getCost() const;
     double getDemand() const;
 
+    /**
+     * @brief Reduced cost of the column.
+     * @param [std::vector<double>]: dual values of the RMP constraints: the
+     * covering constraints (one for each vertex) followed by the k-routes
+     * constraint.
+     * @return [double]: reduced cost.
+     */
+    double getReducedCost(const std::vector<double>& duals) const;
+
+    /**
+     * @brief Sum of the given values of the edges of the route (following its
+     * sequence from the last vertex back to the first one).
+     */
+    double getEdgeSum(const utils::Vec2D<double>& values) const;
+
+    /**
+     * @brief # of edges of the route (following its sequence) with one end
+     * point in the set and the other out of it.
+     * @param [std::vector<bool>]: indicator of the vertices in the set.
+     */
+    int getNbCrossings(const std::vector<bool>& inSet) const;
+
+    /**
+     * @brief Coefficient of the route in the subset-row cut of the given
+     * triple: 1 if it visits at least two of its customers, 0 otherwise.
+     */
+    int getSubsetRowCoeff(const std::array<int, 3>& set) const;
+
+    /**
+     * @brief Checks if i and j are consecutive in the sequence of the route.
+     */
+    bool hasEdge(const int i, const int j) const;
+
+    /**
+     * @brief Checks if the route satisfies the branching constraints.
+     */
+    bool isCompatible(const std::vector<BranchingConstr>& constrs) const;
+
     bool addVertex(const int i);
 
     void setCost(const double cost);
 
+    /**
+     * @brief Replaces the sequence of the route by the given one (the same
+     * vertices in another order) and its cost.
+     */
+    void setRoute(const std::vector<int>& route, const double cost);
+
 private:
 
     double mCost;
     double mDemand;
     std::vector<bool> mContained;
-    std::vector<int> mRoute; // TODO
+    std::vector<int> mRoute; // vertices in visiting order (if known)
     std::shared_ptr<const Instance> mpInst;
 };
 
@@ -0,0 +1,198 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: espprc_labeling.hpp
+ *
+ * @brief Labeling algorithm for the elementary shortest path problem with
+ * resource (capacity) constraints (ESPPRC) class declaration. It is an
+ * alternative to the PCTSP subproblem (PctspIlp) of the column generation
+ * algorithm [1]. The labels are extended forward (from the depot) up to half
+ * of the capacity and complete routes are obtained by joining pairs of labels
+ * (as the costs are symmetric the backward labels are the forward ones). The
+ * labels are stored in capacity buckets and elementarity is relaxed by the
+ * ng-route relaxation [2] with dynamic augmentation of the ng-neighbourhoods
+ * [3], so only elementary routes are returned as columns. Each label keeps the
+ * parity of the customers visited of each subset-row cut priced [4]: the
+ * penalty of a cut is paid when the second customer is visited. The edges
+ * forbidden by the branching have infinite reduced cost and each label keeps
+ * the vertex that must follow its last one by the forced edges.
+ *
+ * Created on October 17, 2026, 02:20 PM
+ *
+ * References:
+ * [1] G. Righini and M. Salani. Symmetry helps: Bounded bi-directional dynamic
+ * programming for the elementary shortest path problem with resource
+ * constraints. Discrete Optimization, 3(3):255-273, 2006.
+ * [2] R. Baldacci, A. Mingozzi, and R. Roberti. New route relaxation and
+ * pricing strategies for the vehicle routing problem. Operations Research,
+ * 59(5):1269-1283, 2011.
+ * [3] R. Roberti and A. Mingozzi. Dynamic ng-path relaxation for the delivery
+ * man problem. Transportation Science, 48(3):413-424, 2014.
+ * [4] M. Jepsen, B. Petersen, S. Spoorendonk, and D. Pisinger. Subset-row
+ * inequalities applied to the vehicle-routing problem with time windows.
+ * Operations Research, 56(2):497-511, 2008.
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ESPPRC_LABELING_HPP
+#define ESPPRC_LABELING_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include "../config_parameters.hpp"
+#include "../utils/multi_vector.hpp"
+#include "pricing.hpp"
+
+class Column;
+class Instance;
+
+class EspprcLabeling : public Pricing
+{
+public:
+
+    EspprcLabeling() = default;
+    EspprcLabeling(const EspprcLabeling& other) = default;
+    EspprcLabeling(EspprcLabeling&& other) = default;
+    ~EspprcLabeling() = default;
+    EspprcLabeling& operator=(const EspprcLabeling& other) = default;
+    EspprcLabeling& operator=(EspprcLabeling&& other) = default;
+
+    EspprcLabeling(const ConfigParameters::cg& params,
+                   const std::shared_ptr<const Instance>& pInst);
+
+    void setBranchingConstrs(
+        const std::vector<BranchingConstr>& constrs) override;
+
+    void setDuals(const std::vector<double>& duals) override;
+
+    void setEdgeDuals(const utils::Vec2D<double>& edgeDuals) override;
+
+    void setSubsetRowDuals(const std::vector<SubsetRowCut>& cuts) override;
+
+    bool solve() override;
+
+    std::vector<std::pair<Column, double>> extractColumns() override;
+
+    double getReducedCostBound() const override;
+
+private:
+
+    using Bitset = std::vector<std::uint64_t>;
+
+    struct Label
+    {
+        int vertex_;        // last vertex of the path
+        int parent_;        // index of the predecessor label (-1: depot)
+        double cost_;       // reduced cost of the path
+        double load_;       // demand collected
+        Bitset mem_;        // ng-memory
+        Bitset visited_;    // branching vertices visited (exact)
+        Bitset srState_;    // subset-row cuts with one customer visited
+        int next_;          // vertex that must follow (forced edge), -1: any
+        bool dominated_;
+    };
+
+    ConfigParameters::cg mParams;
+
+    // dual values being priced
+    std::vector<double> mDuals;
+    // duals of the RMP cuts on the edges
+    utils::Vec2D<double> mEdgeDuals;
+    // reduced cost of the edges (the prizes are split between the end points)
+    utils::Vec2D<double> mRc;
+    // subset-row cuts priced and the cuts of each customer
+    std::vector<SubsetRowCut> mSrCuts;
+    utils::Vec2D<int> mSrCutsOf;
+    // ng-neighbourhoods
+    std::vector<Bitset> mNg;
+
+    // branching constraints of the node
+    std::vector<BranchingConstr> mBranching;
+    // vertices in some branching constraint
+    std::vector<bool> mIsBranchingVertex;
+    // end points of the edges forced by the branching at each vertex
+    utils::Vec2D<int> mForcedPartners;
+
+    // labels created in the last run
+    std::vector<Label> mLabels;
+    // labels indexes: vertex x capacity bucket
+    utils::Vec3D<int> mBuckets;
+    // capacity of each bucket
+    double mBucketStep;
+
+    // columns found in the last solve
+    std::vector<std::pair<Column, double>> mColumns;
+    // lower bound on the reduced cost of any column
+    double mRcBound;
+
+    std::shared_ptr<const Instance> mpInst;
+
+    /**
+     * @brief Each ng-neighbourhood has the cg_ng_size nearest customers.
+     */
+    void initNgNeighbourhoods();
+
+    /**
+     * @brief Reduced cost of each edge: its cost minus its dual minus half of
+     * the prizes of its end points.
+     */
+    void updateReducedCosts();
+
+    /**
+     * @brief Forward labeling bounded at half of the capacity.
+     */
+    void runLabeling();
+
+    /**
+     * @brief Vertex that must follow v (reached from p) by the forced edges.
+     * @param [Bitset]: branching vertices visited before v.
+     * @return [int]: the vertex, -1 if any vertex may follow and -2 if the
+     * forced edges can not be satisfied.
+     */
+    int getForcedNext(const int v, const int p, const Bitset& visited) const;
+
+    /**
+     * @brief Adds the label if it is not dominated and marks as dominated the
+     * labels (at the same vertex) dominated by it.
+     * @return [int]: index of the label added, -1 if it is dominated.
+     */
+    int addLabel(Label&& label);
+
+    /**
+     * @brief Sum of the penalties of the subset-row cuts in state a and not
+     * in state b: the least extra cost the path of a may pay w.r.t. the path
+     * of b in any completion.
+     */
+    double srPenalty(const Bitset& a, const Bitset& b) const;
+
+    /**
+     * @brief Joins pairs of labels (and closes single labels at the depot) to
+     * build the elementary routes with negative reduced cost (the columns) and
+     * the reduced cost bound.
+     * @return [std::vector<int>]: customers of the route with least reduced
+     * cost (possibly non-elementary), empty if no route has negative reduced
+     * cost.
+     */
+    std::vector<int> joinLabels();
+
+    /**
+     * @brief Checks if a route visiting (exactly) the given branching
+     * vertices satisfies the (Ryan-Foster) branching constraints. The edge
+     * constraints are satisfied by the labels.
+     */
+    bool isCompatible(const Bitset& visited) const;
+
+    /**
+     * @brief Customers of the path of the label (from the depot).
+     */
+    std::vector<int> getPath(const int l) const;
+
+    /**
+     * @brief Adds the repeated vertex of a cycle of the route to the
+     * ng-neighbourhood of every vertex of the cycle.
+     * @return [bool]: true if any ng-neighbourhood changed.
+     */
+    bool augmentNgNeighbourhoods(const std::vector<int>& route);
+};
+
+#endif // ESPPRC_LABELING_HPP
@@ -40,10 +40,13 @@ std::vector<GRBVar> visitVars(GRBModel& model,
                               const std::shared_ptr<const Instance>& pInst);
 
 /**
- * @brief x variables from the TSP subproblem.
+ * @brief x variables from the TSP subproblem. Only the depot edges and the
+ * edges between each customer and its nbNearest nearest customers are created
+ * (the other x vars do not exist).
  */
 utils::Vec2D<GRBVar> routingVars(GRBModel& model,
-                                 const std::shared_ptr<const Instance>& pInst);
+                                 const std::shared_ptr<const Instance>& pInst,
+                                 const int nbNearest);
 
 void coveringConstrs(GRBModel& model,
                      std::vector<GRBConstr>& constrs,
@@ -60,6 +63,7 @@ void kRoutesConstr(GRBModel& model,
 
 // TSP
 void matchingConstrs(GRBModel& model,
+                     std::vector<GRBConstr>& constrs,
                      const std::vector<GRBVar>& y,
                      const utils::Vec2D<GRBVar>& x,
                      const std::shared_ptr<const Instance>& pInst);
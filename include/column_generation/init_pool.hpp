@@ -24,8 +24,9 @@ namespace initPool
 
 /**
  * @brief Randomly generates an initial pool of columns. This algorithm
- * generates n covers. The cost of each column is computed by running the LKH
- * heuristic and finding a TSP solution.
+ * generates n covers. The sequence of each column is a tour built by cheapest
+ * insertion and improved by local search, and its cost is the cost of this
+ * tour.
  * 
  * @param [int]: number of covers (each vertex in at least one column).
  * @param [std::shared_ptr<const Instance>]: pointer to instance.
@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: min_cut_separation.hpp
+ *
+ * @brief Exact separation of the (generalized) subtour elimination constraints
+ * x(E(S)) <= y(S) - y_i of the PCTSP at fractional solutions. By the degree
+ * constraints x(delta(v)) = 2 y_v, the SEC of S and i is violated iff
+ * x(delta(S)) < 2 y_i, so the most violated SEC of each customer i is given by
+ * a minimum cut between the depot and i in the support graph. The minimum
+ * cuts of all the customers are given by the Gomory-Hu cut tree [1] of the
+ * support graph, computed by Gusfield's algorithm [2] with the max-flow code
+ * of CVRPSEP.
+ *
+ * Created on October 17, 2026, 11:30 PM
+ *
+ * References:
+ * [1] R. E. Gomory and T. C. Hu. Multi-terminal network flows. Journal of the
+ * Society for Industrial and Applied Mathematics, 9(4):551-570, 1961.
+ * [2] D. Gusfield. Very simple methods for all pairs network flow analysis.
+ * SIAM Journal on Computing, 19(1):143-155, 1990.
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MIN_CUT_SEPARATION_HPP
+#define MIN_CUT_SEPARATION_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../ext/cvrpsep/mxf.h"
+#include "../utils/multi_vector.hpp"
+
+class Instance;
+
+namespace minCutSep
+{
+
+/**
+ * @brief Buffers of the separation reused across calls (e.g., by a callback):
+ * the max-flow network and the cut tree. A workspace must not be used by
+ * concurrent calls.
+ */
+struct Workspace
+{
+    Workspace(const std::shared_ptr<const Instance>& pInst);
+    Workspace(const Workspace& other) = delete;
+    ~Workspace();
+    Workspace& operator=(const Workspace& other) = delete;
+
+    std::shared_ptr<const Instance> pInst_;
+    MaxFlowPtr maxFlow_;
+    std::vector<int> vertexOf_;     // vertex of each network node (1-based)
+    std::vector<double> cutValue_;  // cut value of each tree node and its
+    std::vector<int> nextOnPath_;   // parent (towards the depot)
+    utils::Vec2D<int> shores_;      // customers of the subtree of each node
+    std::vector<double> maxY_;      // greatest y_i of each shore
+    // violation and tree node of the violated shores
+    std::vector<std::pair<double, int>> violated_;
+};
+
+/**
+ * @brief Separates the SECs by the minimum cuts between the depot and the
+ * visited customers (the shores of the cut tree edges).
+ * @param [utils::Vec2D<double>]: edge values (xVal[i][j], i < j, where 0 is
+ * the depot).
+ * @param [std::vector<double>]: visit values.
+ * @param [int]: maximum number of sets.
+ * @param [double]: least violation y_i - x(delta(S)) / 2 of the SEC of the
+ * greatest y_i of a set.
+ * @param [utils::Vec2D<int>&]: sorted sets of customers, the most violated
+ * first, written to its first entries (the others are buffers kept for the
+ * next calls).
+ * @return [int]: number of sets.
+ */
+int separateSecs(const utils::Vec2D<double>& xVal,
+                 const std::vector<double>& yVal,
+                 const int maxNbSets,
+                 const double minViolation,
+                 Workspace& ws,
+                 utils::Vec2D<int>& sets);
+
+} // minCutSep namespace
+
+#endif // MIN_CUT_SEPARATION_HPP
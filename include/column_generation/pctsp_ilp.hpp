@@ -6,7 +6,12 @@
  * Bixby-Coullard-Simchi-Levi CG subproblem [1] class declaration. This model is
  * used as the subproblem of the column generation algorithm as described by
  * [1, 2]. Note, however, that we only use the subtour elimination constraints
- * (SEC) rather than others cuts as [1].
+ * (SEC) rather than others cuts as [1]. The model starts with a granular edge
+ * set (depot and nearest neighbours edges) and the other edges are added only
+ * when they may improve the solution. Before each solve, the customers whose
+ * prize can not pay their least detour are fixed out of the model. Each
+ * subset-row cut of the RMP with nonzero dual has a binary var w >= (y_a + y_b
+ * + y_c - 1) / 2 with its penalty (minus its dual) as cost.
  *
  * Created on April 18, 2022, 11:12 PM
  * 
@@ -23,15 +28,19 @@
 #ifndef PCTSP_ILP_HPP
 #define PCTSP_ILP_HPP
 
+#include <set>
+#include <tuple>
+
 #include "../base_lp.hpp"
 #include "../utils/multi_vector.hpp"
+#include "pricing.hpp"
 
 class CallbackSEC;
 class Column;
 class Instance;
 class SetCoveringLp;
 
-class PctspIlp : public BaseLp
+class PctspIlp : public BaseLp, public Pricing
 {
 public:
 
@@ -42,24 +51,193 @@ public:
     PctspIlp& operator=(const PctspIlp& other) = default;
     PctspIlp& operator=(PctspIlp&& other) = default;
 
-    PctspIlp(const std::shared_ptr<SetCoveringLp>& pRMP,
-               const std::shared_ptr<const Instance>& pInst);
+    PctspIlp(const ConfigParameters::cg& params,
+             const std::shared_ptr<SetCoveringLp>& pRMP,
+             const std::shared_ptr<const Instance>& pInst);
+
+    /**
+     * @brief Constructor of a model with its own GUROBI environment, so that
+     * it can be solved concurrently with the other models.
+     * @param [int]: random seed of the solver.
+     */
+    PctspIlp(const ConfigParameters::cg& params,
+             const int seed,
+             const std::shared_ptr<const Instance>& pInst);
+
+    /**
+     * @brief Adds y_i = y_j (together) or y_i + y_j <= 1 (separate) for each
+     * branching constraint.
+     */
+    void setBranchingConstrs(
+        const std::vector<BranchingConstr>& constrs) override;
+
+    void setDuals(const std::vector<double>& duals) override;
+
+    /**
+     * @brief Sets the x vars obj coeffs to the edge costs minus the edge duals.
+     */
+    void setEdgeDuals(const utils::Vec2D<double>& edgeDuals) override;
+
+    /**
+     * @brief Replaces the subset-row vars (and constraints) of the previous
+     * cuts if the triples changed and sets their costs.
+     */
+    void setSubsetRowDuals(const std::vector<SubsetRowCut>& cuts) override;
 
-    std::pair<Column, double> extractColumn() const;
+    /**
+     * @brief Routes used (with the last columns extracted) as MIP start
+     * solutions. At each solve, the best ones w.r.t. the current prizes are
+     * set as starts.
+     */
+    void setStartColumns(const std::vector<Column>& columns) override;
 
-    void updateVisitVarsObjCoeff();
+    void setNbThreads(const int nbThreads) override;
+
+    bool solve() override;
+
+    /**
+     * @brief Extract the (at most cg_max_nb_cols_per_iter) best distinct
+     * routes with negative reduced cost from the solution pool of the last
+     * optimization. Routes visiting the same set of vertices are extracted
+     * only once.
+     * @return [std::vector<std::pair<Column, double>>]: columns and their
+     * reduced costs sorted by reduced cost.
+     */
+    std::vector<std::pair<Column, double>> extractColumns() override;
+
+    /**
+     * @brief Lower bound on the reduced cost of any column w.r.t. the dual
+     * values of the last update (valid after the optimization).
+     */
+    double getReducedCostBound() const override;
+
+    /**
+     * @brief Set the prizes (y vars obj coeffs) to the given dual values.
+     * @param [std::vector<double>]: dual values of the RMP constraints: the
+     * covering constraints (one for each vertex) followed by the k-routes
+     * constraint.
+     */
+    void updateVisitVarsObjCoeff(const std::vector<double>& duals);
 
 private:
 
+    struct PoolCut
+    {
+        std::vector<int> set_;          // customers of the capacity cut
+        std::vector<GRBConstr> constrs_; // one constraint for each customer
+        int nbActive_;  // # of solves in which the cut was tight
+        int age_;       // # of solves since the cut was last tight
+    };
+
+    ConfigParameters::cg mParams;
+
+    // dual of the k-routes constraint used in the last update
+    double mKDual;
+
+    // prizes (dual values) used in the last update
+    std::vector<double> mPrizes;
+    // branching constraints of the node
+    std::vector<BranchingConstr> mBranching;
+    // candidate routes for the start solutions of the next solve
+    std::vector<Column> mStartColumns;
+    // columns extracted in the last solve
+    std::vector<Column> mLastColumns;
+    // lower bound on the objective of any route with an edge not in the model
+    double mExcludedEdgesBound;
+    // customers fixed out of the model (unprofitable at the current prizes)
+    std::vector<bool> mIsFixed;
+    // least objective of the single customer routes of the fixed customers
+    double mFixedVisitsBound;
+    // least detour c_ai + c_ib - c_ab (a != b) to visit each customer
+    // (-infinity if a shortcut (a, b) is forbidden)
+    std::vector<double> mMinDetours;
+    // edge costs in the objective (costs minus the edge duals)
+    utils::Vec2D<double> mEdgeCosts;
+
     // visit variables
     std::vector<GRBVar> m_y;
-    // routing variables
+    // routing variables (sparse: only the edges in the model exist)
     utils::Vec2D<GRBVar> m_x;
+    // matching (degree) constraints of each vertex
+    std::vector<GRBConstr> mMatchingConstrs;
+    // subset-row cuts priced: their vars (1 if the route visits at least two
+    // customers of the cut) and constraints
+    std::vector<SubsetRowCut> mSrCuts;
+    std::vector<GRBVar> m_w;
+    std::vector<GRBConstr> mSrConstrs;
+    // two least costs of the edges of each vertex (and the least cost
+    // neighbour)
+    std::vector<std::tuple<double, double, int>> mCheapestEdges;
+
+    // capacity cuts separated in previous solves kept as model constraints
+    std::vector<PoolCut> mCutPool;
+    // sets of the cuts in the pool (installed or pending)
+    std::set<std::vector<int>> mCutPoolSets;
+    // sets of the cuts separated in the last solve not installed yet
+    std::vector<std::vector<int>> mPendingCuts;
 
     std::shared_ptr<SetCoveringLp> mpRMP;
     std::shared_ptr<CallbackSEC> mpCb;
 
     void initModel();
+
+    /**
+     * @brief Computes the two least cost edges and the least detour of each
+     * vertex w.r.t. the edge costs in the objective. The detours are -infinity
+     * while an edge is forbidden by the branching (a shortcut may use it).
+     */
+    void updateEdgeBounds();
+
+    /**
+     * @brief Exactness check of the granular edge set: the objective of any
+     * route using the edge (i, j) is bounded by the half costs of the two
+     * edges of each vertex minus its prize. The edges whose bound may improve
+     * the last solution with a negative reduced cost are added to the model.
+     * @return [int]: number of edges added.
+     */
+    int addImprovingEdges();
+
+    /**
+     * @brief Adds the x var of the edge (i, j) to the model.
+     */
+    void addEdge(const int i, const int j);
+
+    /**
+     * @brief Sets the start solutions (y and x values) from the candidate
+     * routes with least reduced cost at the current prizes. The tour of each
+     * route is built by cheapest insertion.
+     */
+    void setStarts();
+
+    /**
+     * @brief Fixes to zero the visit (and edges) vars of the customers whose
+     * prize is at most their least detour: dropping them from any route with
+     * other customers does not increase its objective. The customers of the
+     * branching constraints and those whose single customer route has
+     * negative reduced cost are kept.
+     */
+    void fixUnprofitableCustomers();
+
+    /**
+     * @brief Updates the activity of the pool cuts at the last solution and
+     * collects the new capacity cuts separated by the callback (the model is
+     * not changed, so the solution remains available).
+     */
+    void updateCutPool();
+
+    /**
+     * @brief Installs the pending cuts as model constraints. If the pool
+     * exceeds cg_cut_pool_size, the cuts that have not been tight for longer
+     * (and less often) are removed. The model is updated (the callback reads
+     * it before the optimization).
+     */
+    void installPendingCuts();
+
+    /**
+     * @brief Adds the capacity cut x(E(S)) <= y(S) - y_i of each i in S to the
+     * model (with the edges of E(S) in the model).
+     */
+    void installCut(std::vector<int>&& set);
 };
 
 #endif // PCTSP_ILP_HPP
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: pricing.hpp
+ *
+ * @brief Pricing problem (CG subproblem) interface. It is implemented by every
+ * exact pricing engine used by the column generation algorithm.
+ *
+ * Created on October 17, 2026, 02:10 PM
+ *
+ * References:
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PRICING_HPP
+#define PRICING_HPP
+
+#include <utility>
+#include <vector>
+
+#include "../utils/multi_vector.hpp"
+#include "branching_constr.hpp"
+#include "subset_row_cut.hpp"
+
+class Column;
+
+class Pricing
+{
+public:
+
+    virtual ~Pricing() = default;
+
+    /**
+     * @brief Restricts the pricing to the routes that satisfy the given
+     * branching constraints (of the branch-and-price node).
+     */
+    virtual void setBranchingConstrs(
+        const std::vector<BranchingConstr>& constrs) = 0;
+
+    /**
+     * @brief Set the dual values to be priced.
+     * @param [std::vector<double>]: dual values of the RMP constraints: the
+     * covering constraints (one for each vertex) followed by the k-routes
+     * constraint.
+     */
+    virtual void setDuals(const std::vector<double>& duals) = 0;
+
+    /**
+     * @brief Set the duals of the RMP cuts on the edges (e.g., the capacity
+     * cuts): the cost of each edge (i, j) in the pricing is c_ij -
+     * edgeDuals[i][j].
+     * @param [utils::Vec2D<double>]: symmetric matrix of the edge duals.
+     */
+    virtual void setEdgeDuals(const utils::Vec2D<double>& edgeDuals) = 0;
+
+    /**
+     * @brief Set the subset-row cuts of the RMP with nonzero dual: the reduced
+     * cost of each route visiting at least two customers of a cut is
+     * increased by minus its dual.
+     */
+    virtual void setSubsetRowDuals(const std::vector<SubsetRowCut>& cuts) = 0;
+
+    /**
+     * @brief Routes that may be used as start (warm) solutions of the next
+     * solve. The engines that do not use start solutions ignore them.
+     */
+    virtual void setStartColumns(const std::vector<Column>&) {}
+
+    /**
+     * @brief Maximum # of threads used by each solve. The engines that are
+     * single threaded ignore it.
+     */
+    virtual void setNbThreads(const int) {}
+
+    /**
+     * @brief Solves the pricing problem at the last duals set.
+     * @return [bool]: false if the pricing problem could not be solved.
+     */
+    virtual bool solve() = 0;
+
+    /**
+     * @brief Extract the (at most cg_max_nb_cols_per_iter) best distinct
+     * columns with negative reduced cost found by the last solve.
+     * @return [std::vector<std::pair<Column, double>>]: columns and their
+     * reduced costs sorted by reduced cost.
+     */
+    virtual std::vector<std::pair<Column, double>> extractColumns() = 0;
+
+    /**
+     * @brief Lower bound on the reduced cost of any column w.r.t. the duals of
+     * the last solve.
+     */
+    virtual double getReducedCostBound() const = 0;
+};
+
+#endif // PRICING_HPP
@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: pricing_bound.hpp
+ *
+ * @brief Pricing lower bound functions declarations. A cheap lower bound on
+ * the least reduced cost of any route is computed before the exact pricing:
+ * if it is non-negative, no column with negative reduced cost exists and the
+ * exact subproblem (the most expensive one being the last solve of CG, which
+ * only proves that no column exists) is not solved.
+ *
+ * Created on October 17, 2026, 08:10 PM
+ *
+ * References:
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PRICING_BOUND_HPP
+#define PRICING_BOUND_HPP
+
+#include <memory>
+#include <vector>
+
+#include "../utils/multi_vector.hpp"
+
+class Instance;
+
+namespace pricingBound
+{
+
+/**
+ * @brief Half-edge knapsack bound: each vertex of a route costs at least half
+ * of its two least cost edges, so the route costs at least the sum of these
+ * half costs. The customers that pay their half cost with their prize are
+ * selected by the linear relaxation of the knapsack problem with the vehicle
+ * capacity.
+ *
+ * @param [std::vector<double>]: dual values of the RMP constraints: the
+ * covering constraints (one for each vertex) followed by the k-routes
+ * constraint.
+ * @param [utils::Vec2D<double>]: duals of the RMP cuts on the edges (they
+ * are subtracted from the edge costs).
+ * @param [std::shared_ptr<const Instance>]: pointer to instance.
+ * @return [double]: lower bound on the reduced cost of any route.
+ */
+double knapsackBound(const std::vector<double>& duals,
+                     const utils::Vec2D<double>& edgeDuals,
+                     const std::shared_ptr<const Instance>& pInst);
+
+} // pricingBound namespace
+
+#endif // PRICING_BOUND_HPP
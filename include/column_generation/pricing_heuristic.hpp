@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: pricing_heuristic.hpp
+ *
+ * @brief Heuristic pricing functions declarations. The routes are built by a
+ * prize-aware greedy insertion (the prizes are the RMP dual values) followed
+ * by a local search. The exact subproblem (PctspIlp) is only needed when these
+ * heuristics fail to find a column with negative reduced cost. The tours of
+ * the columns generated by any pricing are improved by the same local search.
+ *
+ * Created on October 17, 2026, 10:05 AM
+ *
+ * References:
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PRICING_HEURISTIC_HPP
+#define PRICING_HEURISTIC_HPP
+
+#include <memory>
+#include <vector>
+
+class Column;
+class Instance;
+
+namespace pricingHeur
+{
+
+/**
+ * @brief Builds routes by greedy insertion starting from different seed
+ * customers. A customer i is inserted at the position with least cost c_ai +
+ * c_ib - c_ab - pi_i while it is negative and the capacity is not exceeded.
+ * Each route is then improved by 2-opt, drop and insertion moves.
+ *
+ * @param [std::vector<double>]: dual values of the RMP constraints: the
+ * covering constraints (one for each vertex) followed by the k-routes
+ * constraint.
+ * @param [int]: maximum number of columns returned.
+ * @param [std::shared_ptr<const Instance>]: pointer to instance.
+ * @return [std::vector<std::pair<Column, double>>]: distinct columns with
+ * negative reduced cost and their reduced costs sorted by reduced cost.
+ */
+std::vector<std::pair<Column, double>> greedyInsertion(
+    const std::vector<double>& duals,
+    const int maxNbCols,
+    const std::shared_ptr<const Instance>& pInst);
+
+/**
+ * @brief Cost of the (cyclic) tour.
+ */
+double tourCost(const std::vector<int>& tour,
+                const std::shared_ptr<const Instance>& pInst);
+
+/**
+ * @brief Tour (starting at the depot) of the column vertices built by cheapest
+ * insertion.
+ */
+std::vector<int> buildTour(const Column& column,
+                           const std::shared_ptr<const Instance>& pInst);
+
+/**
+ * @brief Improves the tour of the column over its vertices by 2-opt and
+ * Or-opt moves (starting from its sequence or, if the sequence does not have
+ * the column cost, from the cheapest insertion tour). The column keeps the
+ * improved sequence and its cost.
+ * @return [double]: cost decrease of the column.
+ */
+double improveRoute(Column& column,
+                    const std::shared_ptr<const Instance>& pInst);
+
+} // pricingHeur namespace
+
+#endif // PRICING_HEURISTIC_HPP
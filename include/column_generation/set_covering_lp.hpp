@@ -3,7 +3,11 @@
  * File: set_covering_lp.hpp
  * Author: Guilherme O. Chagas
  *
- * @brief CG CVRP main problem declaration.
+ * @brief CG CVRP main problem declaration. Besides the covering and k-routes
+ * constraints, it may have robust rounded capacity cuts on the edge values
+ * given by the routes (their duals are edge costs in the pricing) and
+ * subset-row cuts on triples of customers (non-robust: the pricing tracks the
+ * customers of each cut visited).
  *
  * (I'm sorry for my bad english xD)
  *
@@ -16,8 +20,13 @@
 #ifndef SET_COVERING_LP_HPP
 #define SET_COVERING_LP_HPP
 
+#include <array>
+#include <set>
+#include <span>
+
 #include "../base_lp.hpp"
 #include "../utils/multi_vector.hpp"
+#include "subset_row_cut.hpp"
 
 class Column;
 class Instance;
@@ -26,6 +35,13 @@ class SetCoveringLp : public BaseLp
 {
 public:
 
+    struct CapacityCut
+    {
+        std::vector<int> set_;      // customers (sorted)
+        std::vector<bool> inSet_;   // indicator of the customers
+        double rhs_;                // 2 ceil(d(S) / C)
+    };
+
     SetCoveringLp() = default;
     SetCoveringLp(const SetCoveringLp& other) = default;
     SetCoveringLp(SetCoveringLp&& other) = default;
@@ -37,20 +53,141 @@ public:
     SetCoveringLp(const std::vector<Column>& columns,
                   const std::shared_ptr<const Instance>& pInst);
 
-    void appendColumn(const Column& columns);
+    void appendColumn(const Column& column);
+
+    /**
+     * @brief Adds the columns to the model: their y vars are created (with
+     * their covering and k-routes coefficients) by a single batched call.
+     */
+    void appendColumns(std::span<const Column> columns);
 
     int getNbCols() const;
 
-    double getDual(const int i) const;
+    int getNbInactiveCols() const;
+
+    /**
+     * @brief All the columns generated: the ones in the model followed by the
+     * inactive ones.
+     */
+    std::vector<Column> getColumns() const;
+
+    /**
+     * @brief Columns with positive value in the last solution and their
+     * values.
+     */
+    std::vector<std::pair<Column, double>> getSolution();
+
+    /**
+     * @brief Value of the artificial variable in the last solution (positive
+     * if the columns in the model do not give a feasible solution).
+     */
+    double getArtificialVal() const;
+
+    /**
+     * @brief Dual values of the covering constraints (one for each vertex)
+     * followed by the k-routes constraint, the capacity cuts and the
+     * subset-row cuts.
+     */
+    std::vector<double> getDuals();
+
+    /**
+     * @brief Reduced cost of the column at the given dual values (of all the
+     * constraints, as returned by getDuals()).
+     */
+    double getReducedCost(const Column& column,
+                          const std::vector<double>& duals) const;
+
+    /**
+     * @brief Duals of the capacity cuts on the edges: the dual of each cut is
+     * added to the edges with one end point in its set.
+     * @param [std::vector<double>]: dual values (of all the constraints).
+     * @return [utils::Vec2D<double>]: symmetric matrix of the edge duals.
+     */
+    utils::Vec2D<double> getEdgeDuals(const std::vector<double>& duals) const;
+
+    const std::vector<CapacityCut>& getCapacityCuts() const;
+
+    /**
+     * @brief Subset-row cuts with nonzero dual at the given dual values (of
+     * all the constraints).
+     */
+    std::vector<SubsetRowCut> getSubsetRowDuals(
+        const std::vector<double>& duals) const;
+
+    const std::vector<std::array<int, 3>>& getSubsetRowCuts() const;
+
+    /**
+     * @brief Separates the rounded capacity cuts x(delta(S)) >= 2 ceil(d(S) /
+     * C) violated by the edge values of the last solution (x_e is the sum of
+     * the values of the routes using the edge e) and adds them to the model.
+     * The cuts are robust: the coefficient of a route is the # of its edges in
+     * delta(S).
+     * @param [int]: maximum number of cuts separated.
+     * @return [int]: number of cuts added.
+     */
+    int addCapacityCuts(const int maxNbCuts);
+
+    /**
+     * @brief Separates the subset-row cuts on triples of customers violated by
+     * the last solution (by enumeration of the triples of customers in the
+     * fractional routes) and adds the most violated ones to the model.
+     * @param [int]: maximum number of cuts added.
+     * @return [int]: number of cuts added.
+     */
+    int addSubsetRowCuts(const int maxNbCuts);
 
     void imposeIntegrality();
 
-    bool isSolutionInteger() const;
+    bool isSolutionInteger();
+
+    /**
+     * @brief Updates the age of the columns w.r.t. the last optimization: it is
+     * reset if the column is basic (or its reduced cost is zero) and increased
+     * otherwise. The columns older than the given age are removed from the
+     * model and moved to the inactive pool.
+     * @param [int]: maximum age of a column in the model.
+     * @return [int]: number of columns removed.
+     */
+    int purgeColumns(const int maxAge);
+
+    /**
+     * @brief Adds back to the model the inactive columns with negative reduced
+     * cost at the given dual values.
+     * @param [std::vector<double>]: dual values of the covering constraints
+     * followed by the k-routes constraint.
+     * @return [int]: number of columns added.
+     */
+    int reactivateColumns(const std::vector<double>& duals);
+
+    /**
+     * @brief Adds back to the model all the inactive columns.
+     */
+    void restoreInactiveColumns();
 
 private:
 
     std::vector<GRBVar> m_y;
     std::vector<GRBConstr> mConstrs;
+    // artificial variable (with big cost) in every constraint: it keeps the
+    // RMP feasible when the columns are restricted by branching
+    GRBVar m_a;
+
+    // columns of the y vars (same indexes)
+    std::vector<Column> mColumns;
+    // # of consecutive iterations each column has been out of the basis
+    std::vector<int> mAges;
+    // columns removed from the model
+    std::vector<Column> mInactiveColumns;
+
+    // capacity cuts (their constraints follow the k-routes one in mConstrs)
+    std::vector<CapacityCut> mCapacityCuts;
+    // sets of the capacity cuts
+    std::set<std::vector<int>> mCapacityCutSets;
+
+    // subset-row cuts (their constraints follow the capacity cuts in the
+    // duals)
+    std::vector<std::array<int, 3>> mSubsetRowCuts;
+    std::vector<GRBConstr> mSubsetRowConstrs;
 
     void initModel(const std::vector<Column>& columns);
 };
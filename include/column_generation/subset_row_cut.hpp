@@ -0,0 +1,30 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: subset_row_cut.hpp
+ *
+ * @brief Subset-row cut [1] of the RMP on a triple S of customers: the routes
+ * visiting at least two customers of S sum at most 1. In the pricing, the
+ * reduced cost of these routes is increased by the (nonpositive) dual of the
+ * cut.
+ *
+ * Created on October 17, 2026, 09:40 PM
+ *
+ * References:
+ * [1] M. Jepsen, B. Petersen, S. Spoorendonk, and D. Pisinger. Subset-row
+ * inequalities applied to the vehicle-routing problem with time windows.
+ * Operations Research, 56(2):497-511, 2008.
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SUBSET_ROW_CUT_HPP
+#define SUBSET_ROW_CUT_HPP
+
+#include <array>
+
+struct SubsetRowCut
+{
+    std::array<int, 3> set_; // customers (sorted)
+    double dual_;            // dual value (<= 0)
+};
+
+#endif // SUBSET_ROW_CUT_HPP
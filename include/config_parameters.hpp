@@ -29,9 +29,52 @@ public:
     */
     struct cg
     {
+        enum class stabilization {none, wentges};
+        enum class pricingEngine {pctsp, labeling};
+        enum class sepNodePolicy {all, root, interval, first};
+
         int initPoolSize_;  // # of columns in the initial pool
         int maxIter_;       // max CG iterations
         int timeLimit_;     // execution time limit
+        int maxNbColsPerIter_; // max # of columns added per CG iteration
+        int colMaxAge_;     // # of iterations before purging a column
+        bool pricingHeuristic_; // try the heuristic pricing before the exact
+        pricingEngine pricingEngine_; // exact pricing algorithm
+        int nbPricingWorkers_; // # of pricing engines solved in parallel
+        bool earlyExitPricing_; // stop the PCTSP at a negative column
+        double earlyExitRc_; // reduced cost that stops the PCTSP
+        int ngSize_;        // # of customers in the ng-neighbourhoods
+        int nbNearestEdges_; // # of nearest neighbours edges in the PCTSP
+        int cutPoolSize_;   // max # of capacity cuts kept in the PCTSP
+        int nbCutRounds_;   // max # of capacity cuts rounds in the RMP
+        int maxNbSrCuts_;   // max # of subset-row cuts added per round
+        int sepCompMaxCuts_; // max # of component SECs per PCTSP callback
+        double sepCompMinViolation_; // least violation of a component SEC
+        int sepCapMaxCuts_; // max # of CVRPSEP capacity sets per callback
+        double sepCapMinViolation_; // least violation of a capacity SEC
+        int sepMinCutMaxCuts_; // max # of min cut sets per callback
+        double sepMinCutMinViolation_; // least violation of a min cut SEC
+        int sepSecsPerSet_; // max # of SECs of a set per callback (0: all)
+        int sepMaxCutsPerRound_; // max # of SECs per callback
+        int sepMaxCutsPerNode_; // max # of SECs per B&B node (0: no limit)
+        double sepTreeMinViolation_; // least violation of a SEC out of root
+        sepNodePolicy sepNodePolicy_; // B&B nodes where the SECs are separated
+        int sepNodeInterval_; // separate at every k-th node (interval)
+        int sepMaxNodes_;   // # of first nodes explored separated (first)
+        int sepTailingOffRounds_; // rounds without gain that stop a node
+        double sepTailingOffGain_; // least relative gain of a round
+        stabilization stabilization_; // dual stabilization technique
+        double smoothingAlpha_; // smoothing factor (< 0: automatic)
+        double gapTolerance_; // relative gap between the RMP and the LB
+    };
+
+    /**
+     * @brief Branch-and-price parameters.
+    */
+    struct bp
+    {
+        int nbThreads_;     // # of nodes solved in parallel
+        int timeLimit_;     // execution time limit
     };
 
     /**
@@ -85,6 +128,8 @@ public:
 
     const cg& getCgParams() const;
 
+    const bp& getBpParams() const;
+
     /**
      * @brief 
      */
@@ -114,6 +159,9 @@ private:
     // Column generation parameters
     ConfigParameters::cg mCgParam;
 
+    // Branch-and-price parameters
+    ConfigParameters::bp mBpParam;
+
     // Model parameters
     ConfigParameters::model mModelParam;
 
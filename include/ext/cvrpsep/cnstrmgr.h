@@ -62,6 +62,7 @@ typedef CnstrMgrRecord *CnstrMgrPointer;
 
 
 void CMGR_CreateCMgr(CnstrMgrPointer *CMP, int Dim);
+void CMGR_ExpandCMgr(CnstrMgrPointer CMP, int NewDim); // modified
 void CMGR_FreeMemCMgr(CnstrMgrPointer *CMP);
 void CMGR_AddCnstr(CnstrMgrPointer CMP,
                    int CType, int Key, int IntListSize, int *IntList,
@@ -21,6 +21,7 @@
 #include <iterator>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 #include "../ext/loguru/loguru.hpp"
 
@@ -96,6 +97,15 @@ void printVars(const utils::Vec4D<GRBVar>& vars);
 */
 bool varExists(const GRBVar& var);
 
+/**
+ * @brief Hash of a vector of integers (e.g., a sorted set of vertices) to be
+ * used by the unordered containers.
+*/
+struct VectorHash
+{
+    std::size_t operator()(const std::vector<int>& v) const;
+};
+
 } // tools namespace
 
 } // utils namespace
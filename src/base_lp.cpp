@@ -116,6 +116,61 @@ GRBConstr BaseLp::getConstrByName(const std::string& name)
 }
 
 
+std::vector<double> BaseLp::getDuals(std::span<const GRBConstr> constrs)
+{
+    std::unique_ptr<double[]> pi(mModel.get(GRB_DoubleAttr_Pi,
+                                            constrs.data(),
+                                            constrs.size()));
+
+    return std::vector<double>(pi.get(), pi.get() + constrs.size());
+}
+
+
+std::vector<double> BaseLp::getValues(std::span<const GRBVar> vars,
+                                      GRB_DoubleAttr attr)
+{
+    std::unique_ptr<double[]> vals(mModel.get(attr, vars.data(), vars.size()));
+
+    return std::vector<double>(vals.get(), vals.get() + vars.size());
+}
+
+
+std::vector<int> BaseLp::getValues(std::span<const GRBVar> vars,
+                                   GRB_IntAttr attr)
+{
+    std::unique_ptr<int[]> vals(mModel.get(attr, vars.data(), vars.size()));
+
+    return std::vector<int>(vals.get(), vals.get() + vars.size());
+}
+
+
+std::vector<double> BaseLp::getValues(std::span<const GRBConstr> constrs,
+                                      GRB_DoubleAttr attr)
+{
+    std::unique_ptr<double[]> vals(mModel.get(attr,
+                                              constrs.data(),
+                                              constrs.size()));
+
+    return std::vector<double>(vals.get(), vals.get() + constrs.size());
+}
+
+
+void BaseLp::setObj(std::span<const GRBVar> vars, std::span<const double> vals)
+{
+    DCHECK_F(vars.size() == vals.size());
+    mModel.set(GRB_DoubleAttr_Obj, vars.data(), vals.data(), vars.size());
+}
+
+
+void BaseLp::setValues(std::span<const GRBVar> vars,
+                       std::span<const double> vals,
+                       GRB_DoubleAttr attr)
+{
+    DCHECK_F(vars.size() == vals.size());
+    mModel.set(attr, vars.data(), vals.data(), vars.size());
+}
+
+
 GRBEnv& BaseLp::getGRBEnv()
 {
     return mEnv;
@@ -0,0 +1,434 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: branch_and_price.cpp
+ *
+ * @brief Branch-and-price algorithm class definition.
+ *
+ * Created on October 17, 2026, 05:50 PM
+ *
+ * References:
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <tuple>
+
+#include "../../include/ext/loguru/loguru.hpp"
+
+#include "../../include/column_generation/branch_and_price.hpp"
+#include "../../include/column_generation/cg.hpp"
+#include "../../include/instance.hpp"
+#include "../../include/utils/constants.hpp"
+#include "../../include/utils/multi_vector.hpp"
+#include "../../include/utils/stopwatch.hpp"
+
+/* ---------------------------- helper functions  --------------------------- */
+
+namespace
+{
+
+/**
+ * @brief Checks if every column value is integer.
+ */
+bool isInteger(const std::vector<std::pair<Column, double>>& solution)
+{
+    return std::all_of(std::begin(solution), std::end(solution),
+        [](const auto& columnVal)
+        {
+            return std::abs(columnVal.second - std::round(columnVal.second)) <=
+                   utils::GRB_EPSILON;
+        });
+}
+
+/**
+ * @brief Ryan-Foster branching pair: the customers (i, j) such that the sum of
+ * the values of the columns visiting both is fractional and closest to 0.5.
+ * @return [std::pair<int, int>]: the pair, (-1, -1) if there is none.
+ */
+std::pair<int, int> selectBranchingPair(
+    const std::vector<std::pair<Column, double>>& solution,
+    const int n)
+{
+    utils::Vec2D<double> together(n, std::vector<double>(n, 0));
+    for (const auto& [column, val] : solution)
+    {
+        for (int i : column)
+        {
+            for (int j : column)
+            {
+                if (i > 0 && i < j)
+                {
+                    together[i][j] += val;
+                }
+            }
+        }
+    }
+
+    std::pair<int, int> pair{-1, -1};
+    double bestDist = 0.5 - utils::GRB_EPSILON;
+    for (int i = 1; i < n; ++i)
+    {
+        for (int j = i + 1; j < n; ++j)
+        {
+            const double dist = std::abs(together[i][j] - 0.5);
+            if (dist < bestDist)
+            {
+                bestDist = dist;
+                pair = {i, j};
+            }
+        }
+    }
+
+    return pair;
+}
+
+/**
+ * @brief Edge branching: the edge (i, j), i < j, whose flow (sum of the values
+ * of the routes using it) is fractional and closest to 0.5.
+ * @return [std::pair<int, int>]: the edge, (-1, -1) if there is none.
+ */
+std::pair<int, int> selectBranchingEdge(
+    const std::vector<std::pair<Column, double>>& solution,
+    const int n)
+{
+    utils::Vec2D<double> flow(n, std::vector<double>(n, 0));
+    for (const auto& [column, val] : solution)
+    {
+        const std::vector<int> route(std::begin(column), std::end(column));
+        for (std::size_t p = 0; p < route.size(); ++p)
+        {
+            const int a = route[p];
+            const int b = route[(p + 1) % route.size()];
+            flow[std::min(a, b)][std::max(a, b)] += val;
+        }
+    }
+
+    // the routes of a customer without the edge are cut off by the together
+    // branch only if the flow is less than 1
+    std::pair<int, int> edge{-1, -1};
+    double bestDist = 0.5 - utils::GRB_EPSILON;
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = i + 1; j < n; ++j)
+        {
+            const double dist = std::abs(flow[i][j] - 0.5);
+            if (dist < bestDist)
+            {
+                bestDist = dist;
+                edge = {i, j};
+            }
+        }
+    }
+
+    return edge;
+}
+
+/**
+ * @brief Order of the open nodes heap: least lower bound first (and deepest
+ * first among the ties).
+ */
+template <class Node>
+bool worseNode(const Node& a, const Node& b)
+{
+    return a.lb_ > b.lb_ || (a.lb_ == b.lb_ && a.depth_ < b.depth_);
+}
+
+} // anonymous namespace
+
+/* -------------------------------------------------------------------------- */
+
+
+BranchAndPrice::BranchAndPrice(const ConfigParameters::cg& cgParams,
+                               const ConfigParameters::bp& bpParams,
+                               const std::vector<Column>& initialColumns,
+                               const std::shared_ptr<const Instance>& pInst) :
+    mCgParams(cgParams),
+    mBpParams(bpParams),
+    mpInst(pInst),
+    mStop(false),
+    mUnprovenLb(std::numeric_limits<double>::infinity()),
+    mNbNodes(0),
+    mUb(std::numeric_limits<double>::infinity()),
+    mLb(-std::numeric_limits<double>::infinity())
+{
+    // root node
+    mOpenNodes.push_back({{}, initialColumns, mLb, 0});
+}
+
+
+bool BranchAndPrice::execute(const ConfigParameters::solver& solverParams)
+{
+    utils::Stopwatch stopwatch("bp::execute");
+
+    // the solver threads are split among the nodes solved in parallel
+    auto nodeSolverParams = solverParams;
+    if (solverParams.nbThreads_ > 0)
+    {
+        nodeSolverParams.nbThreads_ =
+            std::max(1, solverParams.nbThreads_ / mBpParams.nbThreads_);
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(mBpParams.nbThreads_);
+    for (int t = 0; t < mBpParams.nbThreads_; ++t)
+    {
+        workers.emplace_back(&BranchAndPrice::runWorker, this,
+                             std::cref(nodeSolverParams), std::cref(stopwatch));
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    // the open nodes left (if any) were not pruned
+    std::erase_if(mOpenNodes, [this](const Node& node)
+        {
+            return node.lb_ >= mUb - utils::GRB_EPSILON;
+        });
+    mLb = std::max(mLb, computeLowerBound());
+
+    RAW_LOG_F(INFO, "B&P: UB %.2f, LB %.2f, %d nodes, %d open, %.2fs",
+        mUb, mLb, mNbNodes, static_cast<int>(mOpenNodes.size()),
+        stopwatch.elapsed());
+
+    // the nodes closed without proof may hide better solutions
+    return mOpenNodes.empty() && mUnprovenLb >= mUb - utils::GRB_EPSILON;
+}
+
+
+double BranchAndPrice::getLowerBound() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mLb;
+}
+
+
+double BranchAndPrice::getUpperBound() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mUb;
+}
+
+
+const std::vector<Column>& BranchAndPrice::getSolution() const
+{
+    return mSolution;
+}
+
+/* ----------------------------- private methods ---------------------------- */
+
+void BranchAndPrice::runWorker(const ConfigParameters::solver& solverParams,
+                               const utils::Stopwatch& stopwatch)
+{
+    for (;;)
+    {
+        Node node;
+        double timeLeft = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCv.wait(lock, [this]
+                {
+                    return mStop || !mOpenNodes.empty() || mActiveLbs.empty();
+                });
+
+            // time limit or tree explored (no open and no active nodes)
+            if (mStop || mOpenNodes.empty())
+            {
+                return;
+            }
+
+            // the node is left open if the time is over
+            timeLeft = mBpParams.timeLimit_ - stopwatch.elapsed();
+            if (timeLeft <= 0)
+            {
+                mStop = true;
+                mCv.notify_all();
+                return;
+            }
+
+            std::pop_heap(std::begin(mOpenNodes), std::end(mOpenNodes),
+                          worseNode<Node>);
+            node = std::move(mOpenNodes.back());
+            mOpenNodes.pop_back();
+
+            if (node.lb_ >= mUb - utils::GRB_EPSILON)
+            {
+                mCv.notify_all(); // the tree may have been explored
+                continue; // pruned by bound
+            }
+
+            mActiveLbs.insert(node.lb_);
+            ++mNbNodes;
+        }
+
+        auto children = processNode(node, solverParams, timeLeft);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            mActiveLbs.erase(mActiveLbs.find(node.lb_));
+            for (auto& child : children)
+            {
+                mOpenNodes.push_back(std::move(child));
+                std::push_heap(std::begin(mOpenNodes), std::end(mOpenNodes),
+                               worseNode<Node>);
+            }
+
+            mLb = std::max(mLb, computeLowerBound());
+            mStop = stopwatch.elapsed() >= mBpParams.timeLimit_;
+
+            RAW_LOG_F(INFO, "B&P(%d): UB %.2f, LB %.2f, %d open nodes, %.2fs",
+                mNbNodes, mUb, mLb, static_cast<int>(mOpenNodes.size()),
+                stopwatch.elapsed());
+        }
+
+        mCv.notify_all();
+    }
+}
+
+
+std::vector<BranchAndPrice::Node> BranchAndPrice::processNode(
+    const Node& node,
+    const ConfigParameters::solver& solverParams,
+    const double timeLeft)
+{
+    // the CG of the node stops at the time limit of the B&P
+    auto cgParams = mCgParams;
+    cgParams.timeLimit_ = std::min(cgParams.timeLimit_,
+                                   static_cast<int>(std::ceil(timeLeft)));
+
+    Cg cg(cgParams, node.columns_, node.branching_, mpInst);
+
+    if (!cg.execute(solverParams))
+    {
+        closeUnproven(node.lb_, "the RMP could not be solved");
+        return {};
+    }
+
+    const double lb = std::max(node.lb_, cg.getLowerBound());
+    if (lb >= getUpperBound() - utils::GRB_EPSILON)
+    {
+        return {}; // pruned by bound
+    }
+
+    // the RMP solution is only the node optimum if CG converged
+    const bool isConverged = cg.isConverged();
+
+    if (!cg.isFeasible())
+    {
+        if (!isConverged)
+        {
+            closeUnproven(lb, "CG not converged with the artificial variable");
+        }
+        return {}; // the branching constraints are infeasible
+    }
+
+    const auto solution = cg.getSolution();
+    if (isInteger(solution))
+    {
+        std::vector<Column> routes;
+        for (const auto& [column, val] : solution)
+        {
+            routes.push_back(column);
+        }
+        updateIncumbent(cg.getObjVal(), routes);
+
+        if (!isConverged)
+        {
+            closeUnproven(lb, "CG not converged at an integer solution");
+        }
+        return {};
+    }
+
+    // Ryan-Foster pair or, if there is none (the covering rows may be over
+    // covered), an edge
+    const int n = mpInst->getNbVertices();
+    auto [i, j] = selectBranchingPair(solution, n);
+    const bool isEdge = i < 0;
+    if (isEdge)
+    {
+        std::tie(i, j) = selectBranchingEdge(solution, n);
+    }
+    const auto columns = cg.getColumns();
+
+    // the restricted MIP gives an upper bound at the root node (and at the
+    // nodes that can not be branched)
+    if (node.depth_ == 0 || i < 0)
+    {
+        std::vector<Column> routes;
+        const double cost = cg.solveRestrictedMip(solverParams, routes);
+        updateIncumbent(cost, routes);
+    }
+
+    if (i < 0)
+    {
+        closeUnproven(lb, "no fractional pair of customers nor edge");
+        return {};
+    }
+
+    std::vector<Node> children;
+    for (bool together : {true, false})
+    {
+        Node child{node.branching_, {}, lb, node.depth_ + 1};
+        child.branching_.push_back({i, j, together, isEdge});
+
+        const std::vector<BranchingConstr> constr{child.branching_.back()};
+        std::copy_if(std::begin(columns), std::end(columns),
+                     std::back_inserter(child.columns_),
+            [&constr](const Column& column)
+            {
+                return column.isCompatible(constr);
+            });
+
+        children.push_back(std::move(child));
+    }
+
+    return children;
+}
+
+
+void BranchAndPrice::closeUnproven(const double lb, const char* reason)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    mUnprovenLb = std::min(mUnprovenLb, lb);
+    RAW_LOG_F(WARNING, "B&P: node closed without proof (%s), LB %.2f",
+        reason, lb);
+}
+
+
+void BranchAndPrice::updateIncumbent(const double cost,
+                                     const std::vector<Column>& routes)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (cost < mUb - utils::GRB_EPSILON)
+    {
+        mUb = cost;
+        mSolution = routes;
+        RAW_LOG_F(INFO, "B&P: new incumbent %.2f", mUb);
+    }
+}
+
+
+double BranchAndPrice::computeLowerBound() const
+{
+    double lb = std::min(mUb, mUnprovenLb);
+
+    if (!mOpenNodes.empty())
+    {
+        lb = std::min(lb, mOpenNodes.front().lb_);
+    }
+
+    if (!mActiveLbs.empty())
+    {
+        lb = std::min(lb, *std::begin(mActiveLbs));
+    }
+
+    return lb;
+}
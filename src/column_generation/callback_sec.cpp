@@ -16,110 +16,106 @@
  */
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+
 #include "../../include/ext/loguru/loguru.hpp"
-#include "../../include/ext/cvrpsep/capsep.h"
-#include "../../include/ext/cvrpsep/cnstrmgr.h"
 
 #include "../../include/column_generation/callback_sec.hpp"
+#include "../../include/column_generation/capacity_separation.hpp"
+#include "../../include/column_generation/min_cut_separation.hpp"
 #include "../../include/utils/constants.hpp"
+#include "../../include/utils/tools.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
 
-namespace
+CallbackSEC::CallbackSEC(
+    const ConfigParameters::cg& params,
+    const utils::Vec2D<GRBVar>& x,
+    const std::vector<GRBVar> & y,
+    const std::shared_ptr<const Instance>& p_inst) :
+        mParams(params),
+        mr_x(x),
+        mr_y(y),
+        mpInst(p_inst),
+        mXVal(p_inst->getNbVertices(),
+              std::vector<double>(p_inst->getNbVertices(), 0)),
+        mYVal(p_inst->getNbVertices(), 0),
+        mCompOf(p_inst->getNbVertices(), -1),
+        mCapSepWs(p_inst),
+        mMinCutSepWs(p_inst),
+        mNode(-1),
+        mNbNodeCuts(0),
+        mNodeObj(-std::numeric_limits<double>::infinity()),
+        mNbTailingRounds(0)
 {
+}
 
-static const int cDim = 100; // ?
-static const int cMaxNbCapCuts = 8; // ?
-static const int cMaxNbCombCuts = 20;
 
-/**
- * @brief
-*/
-int checkForDepot(const int i, const int n)
+const std::vector<CallbackSEC::NodeCountStats>&
+CallbackSEC::getNodeCountStats() const
 {
-    return i == n ? 0 : i;
+    return mNodeCountStats;
 }
 
-/*
-* @brief
-*/
-std::vector<double> getDemands(
-    const std::shared_ptr<const Instance>& pInst)
-{
-    std::vector<double> demand(pInst->getNbVertices(), 0);
-
-    for (std::size_t i = 1; i < demand.size(); ++i)
-    {
-        demand[i] = pInst->getdi(i);
-    }
 
-    return demand;
+std::vector<std::vector<int>> CallbackSEC::extractSeparatedSets()
+{
+    std::vector<std::vector<int>> sets;
+    sets.swap(mSeparatedSets);
+    return sets;
 }
 
-/**
- * @brief
-*/
-std::tuple<int, std::vector<int>, std::vector<int>, std::vector<double>>
-    getEdges(
-        const utils::Vec2D<double>& xVal,
-        const int n)
-{
-    int nbEdges = 0;
-    for (int i = 0; i < n; ++i)
-    {
-        for (int j = i + 1; j < n; ++j)
-        {
-            if (xVal[i][j] > utils::GRB_EPSILON)
-            {
-                ++nbEdges;
-            }
-        }
-    }
 
-    std::vector<int> edgeTail;
-    std::vector<int> edgeHead;
-    std::vector<double> edgeX;
+void CallbackSEC::initOptimization()
+{
+    mAddedSets.clear();
+    mNode = -1;
+    mNbNodeCuts = 0;
+    mNodeObj = -std::numeric_limits<double>::infinity();
+    mNbTailingRounds = 0;
+    mNodeCountStats.clear();
+    mEdgeVars.clear();
+    mEdges.clear();
+    mEdgeObj.clear();
+    mYObj.clear();
 
-    if (nbEdges > 0)
+    try
     {
-        edgeTail.reserve(nbEdges + 1);
-        edgeHead.reserve(nbEdges + 1);
-        edgeX.reserve(nbEdges + 1);
-        /* skip first element */
-        edgeTail.push_back(0); 
-        edgeHead.push_back(0);
-        edgeX.push_back(0);
-
-        for (int i = 0; i < n; ++i)
+        for (int i = 0; i < mpInst->getNbVertices(); ++i)
         {
-            for (int j = i + 1; j < n; ++j)
+            DCHECK_F(i < static_cast<int>(mr_x.size()));
+            for (int j = i + 1; j < mpInst->getNbVertices(); ++j)
             {
-                if (xVal[i][j] > utils::GRB_EPSILON)
+                DCHECK_F(j < static_cast<int>(mr_x[i].size()));
+                if (utils::tools::varExists(mr_x[i][j]))
                 {
-                    edgeTail.push_back(i == 0 ? n : i);
-                    edgeHead.push_back(j);
-                    edgeX.push_back(xVal[i][j]);
+                    mEdgeVars.push_back(mr_x[i][j]);
+                    mEdges.push_back({i, j});
+                    mEdgeObj.push_back(mr_x[i][j].get(GRB_DoubleAttr_Obj));
                 }
+                mXVal[i][j] = 0; // edge not in the (granular) model
             }
         }
-    }
 
-    return std::make_tuple(nbEdges, edgeTail, edgeHead, edgeX);
+        for (const auto& y : mr_y)
+        {
+            mYObj.push_back(y.get(GRB_DoubleAttr_Obj));
+        }
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "CallbackSEC::initOptimization(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "CallbackSEC::initOptimization(): Unknown Exception");
+    }
 }
 
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-CallbackSEC::CallbackSEC(
-    const utils::Vec2D<GRBVar>& x,
-    const std::vector<GRBVar> & y,
-    const std::shared_ptr<const Instance>& p_inst) :
-        mr_x(x),
-        mr_y(y),
-        mpInst(p_inst)
-{}
-
 
 void CallbackSEC::callback()
 {
@@ -127,12 +123,12 @@ void CallbackSEC::callback()
     {
         if (where == GRB_CB_MIPSOL)
         {
-            addCVRPSEPCAP(constrsType::lazy);
+            separate(constrsType::lazy);
         }
         else if (where == GRB_CB_MIPNODE &&
                  getIntInfo(GRB_CB_MIPNODE_STATUS) == GRB_OPTIMAL)
         {
-            addCVRPSEPCAP(constrsType::cut);
+            separate(constrsType::cut);
         }
     }
     catch (GRBException& e)
@@ -148,138 +144,402 @@ void CallbackSEC::callback()
 /* -------------------------------------------------------------------------- */
 
 
-int CallbackSEC::addCVRPSEPCAP(const constrsType cstType)
+int CallbackSEC::separate(const constrsType cstType)
 {
-    int nbAdded = 0; // # of lazy/cuts added in this call
+    const auto& xVal = mXVal;
+    const auto& yVal = mYVal;
+
+    // integer solution: every subtour is a violated component (all of them
+    // must be cut off)
+    if (cstType == constrsType::lazy)
+    {
+        /* get solution: routing and visitation */
+        updateValues(cstType);
+        const int nbSets = separateComponents(xVal, yVal,
+            mpInst->getNbVertices(), utils::GRB_EPSILON, mSets);
+        return addSecs(mSets, nbSets, xVal, yVal, utils::GRB_EPSILON, 0,
+                       cstType);
+    }
 
-    /* get solution: routing */
-    auto xVal = getxVarsValues(cstType);
-    /* get solution: visitation */
-    auto yVal = getyVarsValues(cstType);
+    // the node is re-solved (same node count) after each round of cuts
+    const double node = getDoubleInfo(GRB_CB_MIPNODE_NODCNT);
+    if (keepsNodeState() && node != mNode)
+    {
+        mNode = node;
+        mNbNodeCuts = 0;
+        mNodeObj = -std::numeric_limits<double>::infinity();
+        mNbTailingRounds = 0;
+    }
 
-    const int n = mpInst->getNbVertices();
-    
-    auto [nbEdges, edgeTail, edgeHead, edgeX] = getEdges(xVal, n);
-
-
-    if (nbEdges == 0) return nbAdded;
-
-    /* Parameters of the CVRPSEP */
-    char integerAndFeasible;
-    double maxViolation = 0;
-    auto demands = getDemands(mpInst);
-    CnstrMgrPointer cutsCMP, myOldCutsCMP;
-    CMGR_CreateCMgr(&cutsCMP, cDim);
-    CMGR_CreateCMgr(&myOldCutsCMP, cDim);
-
-    CAPSEP_SeparateCapCuts(n - 1,
-                           demands.data(),
-                           mpInst->getC(),
-                           nbEdges,
-                           edgeTail.data(),
-                           edgeHead.data(),
-                           edgeX.data(),
-                           myOldCutsCMP,
-                           cMaxNbCapCuts,
-                           utils::GRB_EPSILON,
-                           utils::GRB_EPSILON,
-                           &integerAndFeasible,
-                           &maxViolation,
-                           cutsCMP);
-
-    for (int c = 0; c < cutsCMP->Size; ++c)
+    const bool isTailingOff = mParams.sepTailingOffRounds_ > 0 &&
+        mNbTailingRounds >= mParams.sepTailingOffRounds_;
+    if (!isScheduled(node) || isTailingOff)
+    {
+        return 0;
+    }
+
+    // cuts budget of the call: the round limit and what is left of the node's
+    int maxNbCuts = mParams.sepMaxCutsPerRound_;
+    if (mParams.sepMaxCutsPerNode_ > 0)
+    {
+        maxNbCuts = std::min(maxNbCuts,
+                             mParams.sepMaxCutsPerNode_ - mNbNodeCuts);
+    }
+    if (maxNbCuts <= 0)
+    {
+        return 0;
+    }
+
+    /* get solution: routing and visitation */
+    updateValues(cstType);
+
+    // node count bucket: [2^b - 1, 2^(b+1) - 1)
+    const int bucket = std::log2(node + 1);
+    if (bucket >= static_cast<int>(mNodeCountStats.size()))
+    {
+        mNodeCountStats.resize(bucket + 1, {0, 0, 0});
+    }
+    auto& stats = mNodeCountStats[bucket];
+
+    // gain of the node relaxation by the last round of cuts (only measured if
+    // the node is tracked)
+    if (keepsNodeState())
     {
-        if (cutsCMP->CPL[c]->CType == CMGR_CT_CAP)
+        const double obj = getObjValue();
+        if (mNodeObj > -std::numeric_limits<double>::infinity())
         {
-            std::vector<int> list;
-            list.reserve(cutsCMP->CPL[c]->IntListSize);
-            for (int j = 1; j <= cutsCMP->CPL[c]->IntListSize; ++j)
+            const double gain = obj - mNodeObj;
+            stats.gain_ += gain;
+            if (gain < mParams.sepTailingOffGain_ *
+                       std::max(1.0, std::abs(obj)))
             {
-                list.push_back(
-                    checkForDepot(cutsCMP->CPL[c]->IntList[j], n));
+                ++mNbTailingRounds;
             }
-
-            GRBLinExpr xExpr = 0, yExpr = 0;
-            double xSum = 0, ySum = 0;
-            for (std::size_t i = 0; i < list.size(); ++i)
+            else
             {
-                for (std::size_t j = 0; j < list.size(); ++j)
-                {
-                    if (list[i] < list[j])
-                    {
-                        xExpr += mr_x[list[i]][list[j]];
-                        xSum += xVal[list[i]][list[j]];
-                    }
-                }
-                yExpr += mr_y[list[i]];
-                ySum += yVal[list[i]];
+                mNbTailingRounds = 0;
             }
 
-            for (std::size_t i = 0; i < list.size(); ++i)
+            if (mParams.sepTailingOffRounds_ > 0 &&
+                mNbTailingRounds >= mParams.sepTailingOffRounds_)
             {
-                if (cstType == constrsType::lazy)
-                {
-                    addLazy(xExpr <= yExpr - mr_y[list[i]]);
-                    ++nbAdded;
-                }
-                else if (xSum - ySum + yVal[list[i]] > utils::GRB_EPSILON)
-                {
-                    addCut(xExpr <= yExpr - mr_y[list[i]]);
-                    ++nbAdded;
-                }
+                return 0;
             }
         }
+        mNodeObj = obj;
+    }
+
+    // only the strong cuts are worth it out of the root node
+    const double treeMinViolation = node > 0 ? mParams.sepTreeMinViolation_ : 0;
+
+    int nbAdded = 0;
+    if (mParams.sepCompMaxCuts_ > 0)
+    {
+        const double minViolation = std::max(mParams.sepCompMinViolation_,
+                                             treeMinViolation);
+        const int nbSets = separateComponents(xVal, yVal,
+            mParams.sepCompMaxCuts_, minViolation, mSets);
+        nbAdded += addSecs(mSets, nbSets, xVal, yVal, minViolation, maxNbCuts,
+                           cstType);
+    }
+
+    // the (costly) CVRPSEP heuristics only if the components are not violated
+    if (nbAdded == 0 && mParams.sepCapMaxCuts_ > 0)
+    {
+        const double minViolation = std::max(mParams.sepCapMinViolation_,
+                                             treeMinViolation);
+        const int nbSets = capSep::separateCapacityCuts(xVal,
+            mParams.sepCapMaxCuts_, mCapSepWs, mSets);
+        nbAdded += addSecs(mSets, nbSets, xVal, yVal, minViolation, maxNbCuts,
+                           cstType);
+    }
+
+    // exact fallback: the heuristics may miss violated SECs
+    if (nbAdded == 0 && mParams.sepMinCutMaxCuts_ > 0)
+    {
+        const double minViolation = std::max(mParams.sepMinCutMinViolation_,
+                                             treeMinViolation);
+        const int nbSets = minCutSep::separateSecs(xVal, yVal,
+            mParams.sepMinCutMaxCuts_, minViolation, mMinCutSepWs, mSets);
+        nbAdded += addSecs(mSets, nbSets, xVal, yVal, minViolation, maxNbCuts,
+                           cstType);
     }
 
-    CMGR_FreeMemCMgr(&cutsCMP);
-    CMGR_FreeMemCMgr(&myOldCutsCMP);
+    mNbNodeCuts += nbAdded;
+    ++stats.nbRounds_;
+    stats.nbCuts_ += nbAdded;
 
     return nbAdded;
 }
 
 
-utils::Vec2D<double> CallbackSEC::getxVarsValues(const constrsType cstType)
+bool CallbackSEC::keepsNodeState() const
 {
-    utils::Vec2D<double> xVal(mpInst->getNbVertices(),
-                              std::vector<double>(mpInst->getNbVertices(), 0));
+    return mParams.sepMaxCutsPerNode_ > 0 || mParams.sepTailingOffRounds_ > 0;
+}
+
+
+bool CallbackSEC::isScheduled(const double node) const
+{
+    using policy = ConfigParameters::cg::sepNodePolicy;
 
-    for (int i = 0; i < mpInst->getNbVertices(); ++i)
+    if (mParams.sepNodePolicy_ == policy::root)
+    {
+        return node == 0;
+    }
+    else if (mParams.sepNodePolicy_ == policy::interval)
     {
-        for (int j = i + 1; j < mpInst->getNbVertices(); ++j)
+        return std::fmod(node, mParams.sepNodeInterval_) == 0;
+    }
+    else if (mParams.sepNodePolicy_ == policy::first)
+    {
+        return node < mParams.sepMaxNodes_;
+    }
+
+    return true;
+}
+
+
+double CallbackSEC::getObjValue() const
+{
+    double obj = 0;
+    for (std::size_t e = 0; e < mEdges.size(); ++e)
+    {
+        obj += mEdgeObj[e] * mXVal[mEdges[e].first][mEdges[e].second];
+    }
+    for (std::size_t i = 0; i < mYObj.size(); ++i)
+    {
+        obj += mYObj[i] * mYVal[i];
+    }
+
+    return obj;
+}
+
+
+int CallbackSEC::addSecs(const utils::Vec2D<int>& sets,
+                         const int nbSets,
+                         const utils::Vec2D<double>& xVal,
+                         const std::vector<double>& yVal,
+                         const double minViolation,
+                         const int maxNbCuts,
+                         const constrsType cstType)
+{
+    // candidate SECs: violation, set and customer i
+    auto& candidates = mCandidates;
+    auto& order = mOrder; // customers of the set by decreasing y_i
+    candidates.clear();
+
+    for (int s = 0; s < nbSets; ++s)
+    {
+        // the lazy constraints may have to be added again (e.g., a solution
+        // found by another thread before they were applied)
+        const auto& list = sets[s];
+        if (cstType == constrsType::cut && mAddedSets.contains(list))
         {
-            DCHECK_F(i < static_cast<int>(mr_x.size()));
-            DCHECK_F(j < static_cast<int>(mr_x[i].size()));
-            if (cstType == constrsType::lazy)
+            continue;
+        }
+
+        double xSum = 0, ySum = 0;
+        for (std::size_t i = 0; i < list.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < list.size(); ++j)
             {
-                xVal[i][j] = getSolution(mr_x[i][j]);
+                xSum += xVal[list[i]][list[j]];
             }
-            else
+            ySum += yVal[list[i]];
+        }
+
+        // the most violated SECs of the set are the ones of its greatest y_i
+        order.assign(std::begin(list), std::end(list));
+        std::sort(std::begin(order), std::end(order),
+            [&yVal](const int i, const int j) { return yVal[i] > yVal[j]; });
+
+        int nbSecs = list.size();
+        if (cstType == constrsType::lazy)
+        {
+            nbSecs = 1;
+        }
+        else if (mParams.sepSecsPerSet_ > 0)
+        {
+            nbSecs = std::min(nbSecs, mParams.sepSecsPerSet_);
+        }
+
+        for (int k = 0; k < nbSecs; ++k)
+        {
+            const double violation = xSum - ySum + yVal[order[k]];
+            if (cstType == constrsType::lazy || violation > minViolation)
             {
-                xVal[i][j] = getNodeRel(mr_x[i][j]);
+                candidates.push_back({violation, s, order[k]});
             }
         }
     }
 
-    return xVal;
+    if (cstType == constrsType::cut)
+    {
+        std::sort(std::begin(candidates), std::end(candidates),
+            [](const auto& a, const auto& b)
+            {
+                return std::get<0>(a) > std::get<0>(b);
+            });
+        if (static_cast<int>(candidates.size()) > maxNbCuts)
+        {
+            candidates.resize(maxNbCuts);
+        }
+    }
+
+    // lhs x(E(S)) - y(S) of the sets used (built once per set)
+    auto& lhs = mLhs;
+    if (static_cast<int>(lhs.size()) < nbSets)
+    {
+        lhs.resize(nbSets);
+    }
+    mIsUsed.assign(nbSets, false);
+    for (const auto& [violation, s, i] : candidates)
+    {
+        const auto& list = sets[s];
+        if (!mIsUsed[s])
+        {
+            mIsUsed[s] = true;
+            lhs[s].clear();
+            for (std::size_t p = 0; p < list.size(); ++p)
+            {
+                for (std::size_t q = p + 1; q < list.size(); ++q)
+                {
+                    if (utils::tools::varExists(mr_x[list[p]][list[q]]))
+                    {
+                        lhs[s] += mr_x[list[p]][list[q]];
+                    }
+                }
+                lhs[s] -= mr_y[list[p]];
+            }
+        }
+
+        if (cstType == constrsType::lazy)
+        {
+            addLazy(lhs[s] + mr_y[i] <= 0);
+        }
+        else
+        {
+            addCut(lhs[s] + mr_y[i] <= 0);
+        }
+    }
+
+    // only the new sets are copied (the buffers stay with the workspace)
+    for (int s = 0; s < nbSets; ++s)
+    {
+        if (mIsUsed[s] && mAddedSets.insert(sets[s]).second)
+        {
+            mSeparatedSets.push_back(sets[s]);
+        }
+    }
+
+    return candidates.size();
 }
 
 
-std::vector<double> CallbackSEC::getyVarsValues(const constrsType cstType)
+int CallbackSEC::separateComponents(const utils::Vec2D<double>& xVal,
+                                    const std::vector<double>& yVal,
+                                    const int maxNbSets,
+                                    const double minViolation,
+                                    utils::Vec2D<int>& sets)
 {
-    std::vector<double> yVal(mpInst->getNbVertices(), 0);
+    const int n = mpInst->getNbVertices();
 
-    for (int i = 0; i < mpInst->getNbVertices(); ++i)
+    // components of the visited customers by depth-first search (the
+    // violated ones are kept in the first entries of mComponents)
+    auto& compOf = mCompOf;
+    std::fill(std::begin(compOf), std::end(compOf), -1);
+    mViolated.clear();
+    int nbComps = 0;
+    for (int s = 1; s < n; ++s)
     {
-        DCHECK_F(i < static_cast<int>(mr_y.size()));
-        if (cstType == constrsType::lazy)
+        if (compOf[s] >= 0 || yVal[s] <= utils::GRB_EPSILON)
         {
-            yVal[i] = getSolution(mr_y[i]);
+            continue;
         }
-        else
+
+        if (nbComps == static_cast<int>(mComponents.size()))
+        {
+            mComponents.emplace_back();
+        }
+        auto& set = mComponents[nbComps];
+        set.assign(1, s);
+        compOf[s] = s;
+        for (std::size_t k = 0; k < set.size(); ++k)
+        {
+            const int i = set[k];
+            for (int j = 1; j < n; ++j)
+            {
+                const double x = i < j ? xVal[i][j] : xVal[j][i];
+                if (compOf[j] < 0 && x > utils::GRB_EPSILON)
+                {
+                    compOf[j] = s;
+                    set.push_back(j);
+                }
+            }
+        }
+
+        // x(E(S)) - y(S) + max_i y_i
+        double violation = 0;
+        double maxY = 0;
+        for (std::size_t p = 0; p < set.size(); ++p)
+        {
+            for (std::size_t q = p + 1; q < set.size(); ++q)
+            {
+                violation += xVal[std::min(set[p], set[q])]
+                                 [std::max(set[p], set[q])];
+            }
+            violation -= yVal[set[p]];
+            maxY = std::max(maxY, yVal[set[p]]);
+        }
+        violation += maxY;
+
+        if (violation > minViolation)
         {
-            yVal[i] = getNodeRel(mr_y[i]);
+            std::sort(std::begin(set), std::end(set));
+            mViolated.push_back({violation, nbComps});
+            ++nbComps;
         }
     }
 
-    return yVal;
+    std::sort(std::begin(mViolated), std::end(mViolated),
+        [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    // the buffers of the sets are swapped (not copied)
+    int nbSets = 0;
+    for (const auto& [violation, c] : mViolated)
+    {
+        if (nbSets >= maxNbSets)
+        {
+            break;
+        }
+        if (nbSets == static_cast<int>(sets.size()))
+        {
+            sets.emplace_back();
+        }
+        std::swap(sets[nbSets], mComponents[c]);
+        ++nbSets;
+    }
+
+    return nbSets;
+}
+
+
+void CallbackSEC::updateValues(const constrsType cstType)
+{
+    // one call for all the vars (the arrays are allocated by GUROBI at each
+    // call and freed here)
+    std::unique_ptr<double[]> x(cstType == constrsType::lazy ?
+        getSolution(mEdgeVars.data(), mEdgeVars.size()) :
+        getNodeRel(mEdgeVars.data(), mEdgeVars.size()));
+    std::unique_ptr<double[]> y(cstType == constrsType::lazy ?
+        getSolution(mr_y.data(), mr_y.size()) :
+        getNodeRel(mr_y.data(), mr_y.size()));
+
+    for (std::size_t e = 0; e < mEdges.size(); ++e)
+    {
+        mXVal[mEdges[e].first][mEdges[e].second] = x[e];
+    }
+
+    std::copy(y.get(), y.get() + mYVal.size(), std::begin(mYVal));
 }
@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: capacity_separation.cpp
+ *
+ * @brief Rounded capacity cuts separation functions definitions.
+ *
+ * @acknowledgment Special thanks to Ph.D. Cleder Marcos Schenekemberg.
+ *
+ * Created on October 17, 2026, 08:50 PM
+ *
+ * References:
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#include "../../include/ext/loguru/loguru.hpp"
+#include "../../include/ext/cvrpsep/capsep.h"
+
+#include "../../include/column_generation/capacity_separation.hpp"
+#include "../../include/instance.hpp"
+#include "../../include/utils/constants.hpp"
+
+/* ---------------------------- helper functions  --------------------------- */
+
+namespace
+{
+
+static const int cDim = 100; // ?
+
+// CVRPSEP keeps global state (e.g., its sorting stacks), so the separation of
+// the models solved in parallel is serialized
+std::mutex cvrpsepMutex;
+
+/**
+ * @brief CVRPSEP index of the depot (n) to its index in the instance (0).
+ */
+int checkForDepot(const int i, const int n)
+{
+    return i == n ? 0 : i;
+}
+
+/**
+ * @brief Edges with positive value in the CVRPSEP format (1-based arrays and
+ * the depot is the vertex n) written to the workspace.
+ * @return [int]: number of edges.
+ */
+int getEdges(const utils::Vec2D<double>& xVal,
+             capSep::Workspace& ws)
+{
+    const int n = ws.pInst_->getNbVertices();
+
+    /* skip first element */
+    ws.edgeTail_.resize(1);
+    ws.edgeHead_.resize(1);
+    ws.edgeX_.resize(1);
+
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = i + 1; j < n; ++j)
+        {
+            if (xVal[i][j] > utils::GRB_EPSILON)
+            {
+                ws.edgeTail_.push_back(i == 0 ? n : i);
+                ws.edgeHead_.push_back(j);
+                ws.edgeX_.push_back(xVal[i][j]);
+            }
+        }
+    }
+
+    return ws.edgeX_.size() - 1;
+}
+
+} // anonymous namespace
+
+/* -------------------------------------------------------------------------- */
+
+
+capSep::Workspace::Workspace(const std::shared_ptr<const Instance>& pInst) :
+    pInst_(pInst),
+    demands_(pInst->getNbVertices(), 0),
+    cutsCMP_(nullptr),
+    oldCutsCMP_(nullptr)
+{
+    for (std::size_t i = 1; i < demands_.size(); ++i)
+    {
+        demands_[i] = pInst->getdi(i);
+    }
+
+    const int nbEdges = pInst->getNbVertices() * (pInst->getNbVertices() - 1);
+    edgeTail_.reserve(nbEdges / 2 + 1);
+    edgeHead_.reserve(nbEdges / 2 + 1);
+    edgeX_.reserve(nbEdges / 2 + 1);
+
+    std::lock_guard<std::mutex> lock(cvrpsepMutex);
+    CMGR_CreateCMgr(&cutsCMP_, cDim);
+    CMGR_CreateCMgr(&oldCutsCMP_, cDim);
+}
+
+
+capSep::Workspace::~Workspace()
+{
+    std::lock_guard<std::mutex> lock(cvrpsepMutex);
+    CMGR_FreeMemCMgr(&cutsCMP_);
+    CMGR_FreeMemCMgr(&oldCutsCMP_);
+}
+
+
+std::vector<std::vector<int>> capSep::separateCapacityCuts(
+    const utils::Vec2D<double>& xVal,
+    const int maxNbCuts,
+    const std::shared_ptr<const Instance>& pInst)
+{
+    Workspace ws(pInst);
+    std::vector<std::vector<int>> sets;
+    sets.resize(separateCapacityCuts(xVal, maxNbCuts, ws, sets));
+    return sets;
+}
+
+
+int capSep::separateCapacityCuts(const utils::Vec2D<double>& xVal,
+                                 const int maxNbCuts,
+                                 Workspace& ws,
+                                 utils::Vec2D<int>& sets)
+{
+    int nbSets = 0;
+
+    const int n = ws.pInst_->getNbVertices();
+
+    const int nbEdges = getEdges(xVal, ws);
+
+    if (nbEdges == 0) return nbSets;
+
+    /* Parameters of the CVRPSEP */
+    char integerAndFeasible;
+    double maxViolation = 0;
+    std::lock_guard<std::mutex> lock(cvrpsepMutex);
+
+    CAPSEP_SeparateCapCuts(n - 1,
+                           ws.demands_.data(),
+                           ws.pInst_->getC(),
+                           nbEdges,
+                           ws.edgeTail_.data(),
+                           ws.edgeHead_.data(),
+                           ws.edgeX_.data(),
+                           ws.oldCutsCMP_,
+                           maxNbCuts,
+                           utils::GRB_EPSILON,
+                           utils::GRB_EPSILON,
+                           &integerAndFeasible,
+                           &maxViolation,
+                           ws.cutsCMP_);
+
+    // the old cuts manager grows geometrically
+    auto& old = ws.oldCutsCMP_;
+    if (old->Dim < old->Size + ws.cutsCMP_->Size)
+    {
+        CMGR_ExpandCMgr(old, std::max(2 * old->Dim,
+                                      old->Size + ws.cutsCMP_->Size));
+    }
+
+    for (int c = 0; c < ws.cutsCMP_->Size; ++c)
+    {
+        const auto& cut = *ws.cutsCMP_->CPL[c];
+        auto& list = ws.list_;
+        list.clear();
+        if (cut.IntListSize > 0)
+        {
+            list.assign(cut.IntList + 1, cut.IntList + 1 + cut.IntListSize);
+        }
+        std::sort(std::begin(list), std::end(list));
+
+        if (cut.CType == CMGR_CT_CAP)
+        {
+            if (nbSets == static_cast<int>(sets.size()))
+            {
+                sets.emplace_back();
+            }
+            auto& set = sets[nbSets++];
+            set.assign(std::begin(list), std::end(list));
+            for (int& i : set)
+            {
+                i = checkForDepot(i, n);
+            }
+            std::sort(std::begin(set), std::end(set));
+        }
+
+        // the manager (and its array of constraints) is reused and the new
+        // cuts are moved to the old ones
+        if (ws.oldSets_.insert(list).second)
+        {
+            CMGR_MoveCnstr(ws.cutsCMP_, old, c, 0);
+        }
+        else
+        {
+            CMGR_ClearCnstr(ws.cutsCMP_, c);
+        }
+    }
+    ws.cutsCMP_->Size = 0;
+
+    return nbSets;
+}
+
+
+int capSep::getMinNbVehicles(const std::vector<int>& set,
+                             const std::shared_ptr<const Instance>& pInst)
+{
+    double demand = 0;
+    for (int i : set)
+    {
+        demand += pInst->getdi(i);
+    }
+
+    return std::ceil(demand / pInst->getC() - utils::GRB_EPSILON);
+}
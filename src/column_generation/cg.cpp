@@ -10,24 +10,93 @@
  */
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <thread>
+
 #include "../../include/ext/loguru/loguru.hpp"
 
 #include "../../include/column_generation/cg.hpp"
 #include "../../include/column_generation/column.hpp"
+#include "../../include/column_generation/espprc_labeling.hpp"
 #include "../../include/column_generation/set_covering_lp.hpp"
 #include "../../include/column_generation/pctsp_ilp.hpp"
+#include "../../include/column_generation/pricing_bound.hpp"
+#include "../../include/column_generation/pricing_heuristic.hpp"
+#include "../../include/instance.hpp"
 #include "../../include/utils/constants.hpp"
 #include "../../include/utils/stopwatch.hpp"
 
+/* ---------------------------- helper functions  --------------------------- */
+
+namespace
+{
+
+// maximum relative perturbation of the prizes priced by the workers
+const double cPrizePerturbation = 0.1;
+
+// maximum # of capacity cuts added to the RMP per separation round
+const int cMaxNbCapCuts = 20;
+
+/**
+ * @brief Sorted vertices of the column.
+ */
+std::vector<int> vertexSet(const Column& column)
+{
+    std::vector<int> vertices(std::begin(column), std::end(column));
+    std::sort(std::begin(vertices), std::end(vertices));
+    return vertices;
+}
+
+}
+
+/* -------------------------------------------------------------------------- */
 
 Cg::Cg(const ConfigParameters::cg& params,
        const std::vector<Column>& initialColumns,
+       const std::vector<BranchingConstr>& branching,
        const std::shared_ptr<const Instance>& pInst) :
     mParams(params),
+    mBranching(branching),
     mpRMP(std::make_shared<SetCoveringLp>(initialColumns, pInst)),
-    mpSubproblem(std::make_shared<PctspIlp>(mpRMP, pInst)),
-    mpInst(pInst)
+    mpSubproblem(params.pricingEngine_ ==
+        ConfigParameters::cg::pricingEngine::labeling ?
+            std::shared_ptr<Pricing>(
+                std::make_shared<EspprcLabeling>(params, pInst)) :
+            std::shared_ptr<Pricing>(
+                std::make_shared<PctspIlp>(params, mpRMP, pInst))),
+    mpInst(pInst),
+    mStabCenterBound(-std::numeric_limits<double>::infinity()),
+    mAlpha(params.smoothingAlpha_ < 0 ? 0.5 : params.smoothingAlpha_),
+    mLb(-std::numeric_limits<double>::infinity()),
+    mConverged(false),
+    mMinColCost(std::numeric_limits<double>::infinity())
 {
+    // every column visits at least one customer
+    for (int i = 1; i < mpInst->getNbVertices(); ++i)
+    {
+        mMinColCost = std::min(mMinColCost, 2 * mpInst->getcij(0, i));
+    }
+
+    mpSubproblem->setBranchingConstrs(mBranching);
+
+    // each worker has its own model (and environment) and random seed
+    for (int w = 1; w < mParams.nbPricingWorkers_; ++w)
+    {
+        if (params.pricingEngine_ ==
+            ConfigParameters::cg::pricingEngine::labeling)
+        {
+            mWorkers.push_back(std::make_shared<EspprcLabeling>(params, pInst));
+        }
+        else
+        {
+            mWorkers.push_back(std::make_shared<PctspIlp>(params, w, pInst));
+        }
+        mWorkers.back()->setBranchingConstrs(mBranching);
+        mWorkerRngs.emplace_back(w);
+    }
 }
 
 
@@ -36,57 +105,519 @@ bool Cg::execute(const ConfigParameters::solver& solverParams)
     utils::Stopwatch stopwatch("cg::execute");
     bool solved = false;
     int iter = 0;
+    double gap = std::numeric_limits<double>::infinity();
 
-    do
+    // the solver threads are split among the pricing engines
+    if (solverParams.nbThreads_ > 0)
     {
-        // solve the restricted main problem
-        solved = mpRMP->optimize(solverParams);
+        const int nbThreads = std::max(1,
+            solverParams.nbThreads_ / mParams.nbPricingWorkers_);
+        mpSubproblem->setNbThreads(nbThreads);
+        for (auto& pWorker : mWorkers)
+        {
+            pWorker->setNbThreads(nbThreads);
+        }
+    }
+
+    // the capacity cuts violated by the CG solution are added to the RMP and
+    // the CG is resumed
+    for (int round = 0; ; ++round)
+    {
+        do
+        {
+            // solve the restricted main problem
+            solved = mpRMP->optimize(solverParams);
+            mConverged = false;
+
+            const double ub = mpRMP->get(GRB_DoubleAttr_ObjVal);
+            gap = (ub - mLb) / std::max(std::abs(ub), utils::GRB_EPSILON);
+
+            RAW_LOG_F(INFO,
+                "CG(%d): UB %.2f, LB %.2f, gap %.4f, %d columns, %.2fs ",
+                iter, ub, mLb, gap, mpRMP->getNbCols(), stopwatch.elapsed());
+
+            ++iter;
+        }
+        while (solved &&
+               iter < mParams.maxIter_ &&
+               stopwatch.elapsed() < mParams.timeLimit_ &&
+               gap > mParams.gapTolerance_ &&
+               generateColumns());
+
+        if (!solved ||
+            round >= mParams.nbCutRounds_ ||
+            iter >= mParams.maxIter_ ||
+            stopwatch.elapsed() >= mParams.timeLimit_ ||
+            !isFeasible())
+        {
+            break;
+        }
+
+        if (addCuts() == 0)
+        {
+            break;
+        }
+    }
+
+    return solved;
+}
+
+
+bool Cg::isConverged() const
+{
+    return mConverged || mLb >= getObjVal() - utils::GRB_EPSILON;
+}
+
+
+double Cg::getLowerBound() const
+{
+    return mLb;
+}
+
+
+double Cg::getObjVal() const
+{
+    return mpRMP->get(GRB_DoubleAttr_ObjVal);
+}
+
+
+std::vector<std::pair<Column, double>> Cg::getSolution() const
+{
+    return mpRMP->getSolution();
+}
 
-        RAW_LOG_F(INFO, "CG(%d): UB %.2f, %d columns, %.2fs ",
-            iter, mpRMP->get(GRB_DoubleAttr_ObjVal), mpRMP->getNbCols(),
-            stopwatch.elapsed());
 
-        ++iter;
+std::vector<Column> Cg::getColumns() const
+{
+    return mpRMP->getColumns();
+}
+
+
+bool Cg::isFeasible() const
+{
+    return mpRMP->getArtificialVal() <= utils::GRB_EPSILON;
+}
+
+
+double Cg::solveRestrictedMip(const ConfigParameters::solver& solverParams,
+                              std::vector<Column>& solution)
+{
+    mpRMP->restoreInactiveColumns();
+    mpRMP->imposeIntegrality();
+    mpRMP->optimize(solverParams);
+
+    solution.clear();
+    if (mpRMP->get(GRB_IntAttr_SolCount) == 0 || !isFeasible())
+    {
+        return std::numeric_limits<double>::infinity();
     }
-    while (solved &&
-           iter < mParams.maxIter_ &&
-           stopwatch.elapsed() < mParams.timeLimit_ &&
-           generateColumn());
 
-    /* post processing step: if solution is fractional, then impose integrality
-       on y variables and solve it again */
-    if (!mpRMP->isSolutionInteger())
+    for (const auto& [column, val] : mpRMP->getSolution())
     {
-        RAW_LOG_F(INFO, "Imposing integrality on y vars...");
-        mpRMP->imposeIntegrality();
-        mpRMP->optimize();
-        RAW_LOG_F(INFO, "ILP: UB %.2f, LB %.2f, gap %.2f, %.2fs ",
-            mpRMP->get(GRB_DoubleAttr_ObjVal),
-            mpRMP->get(GRB_DoubleAttr_ObjBound),
-            mpRMP->get(GRB_DoubleAttr_MIPGap),
-            stopwatch.elapsed());
+        solution.push_back(column);
     }
 
-    return solved;
+    return mpRMP->get(GRB_DoubleAttr_ObjVal);
 }
 
 /* ---------------------------- private methods ----------------------------- */
 
-bool Cg::generateColumn()
+bool Cg::generateColumns()
 {
-    // update the y vars of coeff with the dual values from the main problem
-    mpSubproblem->updateVisitVarsObjCoeff();
+    const auto outDuals = getDuals();
+    double rcBound = 0;
 
-    // solve subproblem
-    mpSubproblem->optimize();
-
-    auto [column, rc] = mpSubproblem->extractColumn();
+    // column management: long unused columns leave the RMP and the inactive
+    // ones that price out at the RMP duals are added back (no pricing needed)
+    if (mpRMP->purgeColumns(mParams.colMaxAge_) > 0)
+    {
+        DRAW_LOG_F(INFO, "CG: %d inactive columns", mpRMP->getNbInactiveCols());
+    }
 
-    if (rc < -utils::GRB_EPSILON)
+    if (mpRMP->reactivateColumns(outDuals) > 0)
     {
-        mpRMP->appendColumn(column);
         return true;
     }
 
-    return false;
+    if (mParams.stabilization_ == ConfigParameters::cg::stabilization::none)
+    {
+        auto columnsRc = price(outDuals, rcBound);
+        updateLowerBound(outDuals, rcBound);
+
+        std::vector<Column> columns;
+        columns.reserve(columnsRc.size());
+        for (const auto& [column, rc] : columnsRc)
+        {
+            DCHECK_F(rc < -utils::GRB_EPSILON);
+            columns.push_back(column);
+        }
+
+        mpRMP->appendColumns(columns);
+        mConverged = columns.empty() && rcBound >= -utils::GRB_EPSILON;
+
+        return !columns.empty();
+    }
+
+    if (mStabCenter.empty())
+    {
+        mStabCenter = outDuals;
+    }
+    DCHECK_F(mStabCenter.size() == outDuals.size());
+
+    // mispricing loop: the separation point moves towards the RMP duals until
+    // a column with negative reduced cost (w.r.t. the RMP duals) is found
+    for (int k = 1; ; ++k)
+    {
+        const double alpha = std::max(0.0, 1 - k * (1 - mAlpha));
+
+        std::vector<double> sepDuals(outDuals.size());
+        for (std::size_t i = 0; i < outDuals.size(); ++i)
+        {
+            sepDuals[i] = alpha * mStabCenter[i] + (1 - alpha) * outDuals[i];
+        }
+
+        auto columnsRc = price(sepDuals, rcBound);
+
+        const double lb = updateLowerBound(sepDuals, rcBound);
+        if (lb > mStabCenterBound)
+        {
+            mStabCenter = sepDuals;
+            mStabCenterBound = lb;
+        }
+
+        std::vector<Column> columns;
+        for (const auto& [column, rc] : columnsRc)
+        {
+            if (mpRMP->getReducedCost(column, outDuals) < -utils::GRB_EPSILON)
+            {
+                columns.push_back(column);
+            }
+        }
+
+        if (!columns.empty())
+        {
+            if (mParams.smoothingAlpha_ < 0)
+            {
+                updateSmoothingFactor(columnsRc.front().first, sepDuals,
+                                      outDuals);
+            }
+
+            mpRMP->appendColumns(columns);
+            return true;
+        }
+
+        if (alpha <= 0)
+        {
+            // the RMP duals were priced: no column remains if the bound
+            // proves it
+            mConverged = rcBound >= -utils::GRB_EPSILON;
+            return false;
+        }
+
+        DRAW_LOG_F(INFO, "CG: mispricing (alpha %.2f)", alpha);
+    }
+}
+
+
+std::vector<double> Cg::getDuals() const
+{
+    return mpRMP->getDuals();
+}
+
+
+std::vector<std::pair<Column, double>> Cg::price(
+    const std::vector<double>& duals,
+    double& rcBound)
+{
+    std::vector<std::pair<Column, double>> columnsRc;
+    rcBound = -std::numeric_limits<double>::infinity();
+
+    // the pricing engines take the duals of the cuts as edge duals
+    const int n = mpInst->getNbVertices();
+    const std::vector<double> routeDuals(std::begin(duals),
+                                         std::begin(duals) + n + 1);
+    const auto edgeDuals = mpRMP->getEdgeDuals(duals);
+    const auto srCuts = mpRMP->getSubsetRowDuals(duals);
+
+    if (mParams.pricingHeuristic_)
+    {
+        columnsRc = pricingHeur::greedyInsertion(routeDuals,
+            mParams.maxNbColsPerIter_, mpInst);
+
+        // the heuristic ignores the branching constraints and the cuts
+        for (auto& [column, rc] : columnsRc)
+        {
+            rc = mpRMP->getReducedCost(column, duals);
+        }
+        std::erase_if(columnsRc, [this](const auto& columnRc)
+            {
+                return !columnRc.first.isCompatible(mBranching) ||
+                       columnRc.second >= -utils::GRB_EPSILON;
+            });
+    }
+
+    // the exact subproblem is only solved if the heuristic failed and the
+    // pricing bound does not prove that no column exists
+    if (columnsRc.empty())
+    {
+        rcBound = pricingBound::knapsackBound(routeDuals, edgeDuals, mpInst);
+        if (rcBound >= -utils::GRB_EPSILON)
+        {
+            DRAW_LOG_F(INFO, "CG: pricing bound %.2f, no column exists",
+                       rcBound);
+            return columnsRc;
+        }
+
+        // the routes of the RMP solution are warm starts of the subproblem
+        std::vector<Column> startColumns;
+        for (const auto& [column, val] : mpRMP->getSolution())
+        {
+            startColumns.push_back(column);
+        }
+
+        // the workers run concurrently with the subproblem
+        std::vector<std::vector<Column>> workersColumns(mWorkers.size());
+        std::vector<std::thread> threads;
+        threads.reserve(mWorkers.size());
+        for (int w = 0; w < static_cast<int>(mWorkers.size()); ++w)
+        {
+            threads.emplace_back([this, w, &routeDuals, &edgeDuals, &srCuts,
+                                  &startColumns, &workersColumns]()
+                {
+                    workersColumns[w] = runWorker(w, routeDuals, edgeDuals,
+                                                  srCuts, startColumns);
+                });
+        }
+
+        // solve the subproblem at the given dual values
+        mpSubproblem->setEdgeDuals(edgeDuals);
+        mpSubproblem->setSubsetRowDuals(srCuts);
+        mpSubproblem->setDuals(routeDuals);
+        mpSubproblem->setStartColumns(startColumns);
+        mpSubproblem->solve();
+
+        columnsRc = mpSubproblem->extractColumns();
+        rcBound = std::max(rcBound, mpSubproblem->getReducedCostBound());
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        // merge the distinct worker columns with negative reduced cost
+        std::set<std::vector<int>> found;
+        for (const auto& [column, rc] : columnsRc)
+        {
+            found.insert(vertexSet(column));
+        }
+
+        for (const auto& columns : workersColumns)
+        {
+            for (const auto& column : columns)
+            {
+                const double rc = mpRMP->getReducedCost(column, duals);
+                if (rc < -utils::GRB_EPSILON &&
+                    found.insert(vertexSet(column)).second)
+                {
+                    columnsRc.push_back({column, rc});
+                }
+            }
+        }
+    }
+
+    // the tours of the new columns are improved (the pricing may stop at a
+    // suboptimal tour of the visited vertices), unless the cuts make the
+    // reduced cost of the improved tour worse or it breaks an edge branching
+    for (auto& [column, rc] : columnsRc)
+    {
+        auto improved = column;
+        if (pricingHeur::improveRoute(improved, mpInst) > 0 &&
+            improved.isCompatible(mBranching))
+        {
+            const double improvedRc = mpRMP->getReducedCost(improved, duals);
+            if (improvedRc < rc)
+            {
+                column = std::move(improved);
+                rc = improvedRc;
+            }
+        }
+    }
+
+    std::sort(std::begin(columnsRc), std::end(columnsRc),
+        [](const auto& a, const auto& b) { return a.second < b.second; });
+
+    return columnsRc;
+}
+
+
+std::vector<Column> Cg::runWorker(const int w,
+                                  const std::vector<double>& duals,
+                                  const utils::Vec2D<double>& edgeDuals,
+                                  const std::vector<SubsetRowCut>& srCuts,
+                                  const std::vector<Column>& startColumns)
+{
+    std::uniform_real_distribution<double> dist(-cPrizePerturbation,
+                                                cPrizePerturbation);
+
+    // only the customers prizes are perturbed
+    auto perturbed = duals;
+    for (int i = 1; i < mpInst->getNbVertices(); ++i)
+    {
+        perturbed[i] *= 1 + dist(mWorkerRngs[w]);
+    }
+
+    auto& pWorker = mWorkers[w];
+    pWorker->setEdgeDuals(edgeDuals);
+    pWorker->setSubsetRowDuals(srCuts);
+    pWorker->setDuals(perturbed);
+    pWorker->setStartColumns(startColumns);
+
+    std::vector<Column> columns;
+    if (pWorker->solve())
+    {
+        for (auto& [column, rc] : pWorker->extractColumns())
+        {
+            columns.push_back(std::move(column));
+        }
+    }
+
+    return columns;
+}
+
+
+int Cg::addCuts()
+{
+    const int n = mpInst->getNbVertices();
+    const int nbCapCuts = mpRMP->getCapacityCuts().size();
+
+    // the subset-row cuts (non-robust) only when no capacity cut is violated
+    int nbNewCapCuts = mpRMP->addCapacityCuts(cMaxNbCapCuts);
+    int nbNewSrCuts = 0;
+    if (nbNewCapCuts == 0 && mParams.maxNbSrCuts_ > 0)
+    {
+        nbNewSrCuts = mpRMP->addSubsetRowCuts(mParams.maxNbSrCuts_);
+    }
+
+    // the new capacity cuts follow the old ones and precede the subset-row
+    // cuts in the duals
+    if (!mStabCenter.empty())
+    {
+        mStabCenter.insert(std::begin(mStabCenter) + n + 1 + nbCapCuts,
+                           nbNewCapCuts, 0);
+        mStabCenter.resize(mStabCenter.size() + nbNewSrCuts, 0);
+    }
+
+    if (nbNewCapCuts > 0)
+    {
+        RAW_LOG_F(INFO, "CG: %d capacity cuts added (%d in the RMP)",
+                  nbNewCapCuts,
+                  static_cast<int>(mpRMP->getCapacityCuts().size()));
+    }
+    else if (nbNewSrCuts > 0)
+    {
+        RAW_LOG_F(INFO, "CG: %d subset-row cuts added (%d in the RMP)",
+                  nbNewSrCuts,
+                  static_cast<int>(mpRMP->getSubsetRowCuts().size()));
+    }
+
+    return nbNewCapCuts + nbNewSrCuts;
+}
+
+
+double Cg::computeLagrangianBound(const std::vector<double>& duals,
+                                  const double rcBound) const
+{
+    return computeDualObj(duals) + mpInst->getK() * rcBound;
+}
+
+
+double Cg::computeFarleyBound(const std::vector<double>& duals,
+                              const double rcBound) const
+{
+    const double dualObj = computeDualObj(duals);
+
+    if (rcBound >= 0)
+    {
+        return dualObj; // the duals are feasible
+    }
+
+    if (mMinColCost <= 0 || dualObj <= 0)
+    {
+        return -std::numeric_limits<double>::infinity();
+    }
+
+    return dualObj / (1 - rcBound / mMinColCost);
+}
+
+
+double Cg::computeDualObj(const std::vector<double>& duals) const
+{
+    const int n = mpInst->getNbVertices();
+    double obj = mpInst->getK() * duals[n];
+    for (int i = 0; i < n; ++i)
+    {
+        obj += duals[i];
+    }
+
+    const auto& cuts = mpRMP->getCapacityCuts();
+    for (std::size_t c = 0; c < cuts.size(); ++c)
+    {
+        obj += cuts[c].rhs_ * duals[n + 1 + c];
+    }
+
+    // the right-hand side of the subset-row cuts is 1
+    for (std::size_t s = n + 1 + cuts.size(); s < duals.size(); ++s)
+    {
+        obj += duals[s];
+    }
+
+    return obj;
+}
+
+
+double Cg::updateLowerBound(const std::vector<double>& duals,
+                            const double rcBound)
+{
+    const double lagrangianLb = computeLagrangianBound(duals, rcBound);
+    const double farleyLb = computeFarleyBound(duals, rcBound);
+
+    mLb = std::max({mLb, lagrangianLb, farleyLb});
+
+    return lagrangianLb;
+}
+
+
+void Cg::updateSmoothingFactor(const Column& column,
+                               const std::vector<double>& sepDuals,
+                               const std::vector<double>& outDuals)
+{
+    // subgradient of the Lagrangian function at the separation point: K
+    // copies of the priced column (the k-routes component is zero)
+    const int n = mpInst->getNbVertices();
+    double dot = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        const double g = 1 - mpInst->getK() * column.contains(i);
+        dot += g * (outDuals[i] - sepDuals[i]);
+    }
+
+    const auto& cuts = mpRMP->getCapacityCuts();
+    for (std::size_t c = 0; c < cuts.size(); ++c)
+    {
+        const double g = cuts[c].rhs_ -
+            mpInst->getK() * column.getNbCrossings(cuts[c].inSet_);
+        dot += g * (outDuals[n + 1 + c] - sepDuals[n + 1 + c]);
+    }
+
+    const auto& srCuts = mpRMP->getSubsetRowCuts();
+    for (std::size_t s = 0; s < srCuts.size(); ++s)
+    {
+        const std::size_t k = n + 1 + cuts.size() + s;
+        const double g = 1 - mpInst->getK() *
+                             column.getSubsetRowCoeff(srCuts[s]);
+        dot += g * (outDuals[k] - sepDuals[k]);
+    }
+
+    mAlpha = dot > 0 ? std::max(0.0, mAlpha - 0.1) :
+                       std::min(0.99, mAlpha + 0.1 * (1 - mAlpha));
 }
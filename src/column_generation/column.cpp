@@ -13,6 +13,8 @@
  */
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "../../include/ext/loguru/loguru.hpp"
 
 #include "../../include/column_generation/column.hpp"
@@ -66,6 +68,95 @@ double Column::getDemand() const
 }
 
 
+double Column::getReducedCost(const std::vector<double>& duals) const
+{
+    DCHECK_F(static_cast<int>(duals.size()) == mpInst->getNbVertices() + 1);
+
+    double rc = mCost - duals[mpInst->getNbVertices()]; // k-routes constr
+    for (int i : mRoute)
+    {
+        rc -= duals[i];
+    }
+
+    return rc;
+}
+
+
+double Column::getEdgeSum(const utils::Vec2D<double>& values) const
+{
+    double sum = 0;
+    for (std::size_t p = 0; p < mRoute.size(); ++p)
+    {
+        sum += values[mRoute[p]][mRoute[(p + 1) % mRoute.size()]];
+    }
+
+    return sum;
+}
+
+
+int Column::getNbCrossings(const std::vector<bool>& inSet) const
+{
+    int nbCrossings = 0;
+    for (std::size_t p = 0; p < mRoute.size(); ++p)
+    {
+        const int next = mRoute[(p + 1) % mRoute.size()];
+        nbCrossings += inSet[mRoute[p]] != inSet[next];
+    }
+
+    return nbCrossings;
+}
+
+
+int Column::getSubsetRowCoeff(const std::array<int, 3>& set) const
+{
+    const int nbVisited = contains(set[0]) + contains(set[1]) +
+                          contains(set[2]);
+    return nbVisited / 2;
+}
+
+
+bool Column::hasEdge(const int i, const int j) const
+{
+    for (std::size_t p = 0; p < mRoute.size(); ++p)
+    {
+        const int next = mRoute[(p + 1) % mRoute.size()];
+        if ((mRoute[p] == i && next == j) || (mRoute[p] == j && next == i))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+bool Column::isCompatible(const std::vector<BranchingConstr>& constrs) const
+{
+    for (const auto& constr : constrs)
+    {
+        // every route visits the depot
+        const bool visitsi = constr.i_ > 0 && contains(constr.i_);
+        const bool visitsj = contains(constr.j_);
+
+        if (constr.edge_)
+        {
+            const bool usesEdge = hasEdge(constr.i_, constr.j_);
+            if (constr.together_ ? (visitsi || visitsj) && !usesEdge :
+                                   usesEdge)
+            {
+                return false;
+            }
+        }
+        else if (constr.together_ ? visitsi != visitsj : visitsi && visitsj)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
 bool Column::addVertex(const int i)
 {
     DCHECK_F(i < static_cast<int>(mContained.size()));
@@ -87,3 +178,14 @@ void Column::setCost(const double cost)
 {
     mCost = cost;
 }
+
+
+void Column::setRoute(const std::vector<int>& route, const double cost)
+{
+    DCHECK_F(route.size() == mRoute.size());
+    DCHECK_F(std::all_of(std::begin(route), std::end(route),
+        [this](const int i) { return contains(i); }));
+
+    mRoute = route;
+    mCost = cost;
+}
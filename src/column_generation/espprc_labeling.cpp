@@ -0,0 +1,779 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: espprc_labeling.cpp
+ *
+ * @brief Labeling algorithm for the elementary shortest path problem with
+ * resource (capacity) constraints (ESPPRC) class definition.
+ *
+ * Created on October 17, 2026, 02:45 PM
+ *
+ * References:
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <set>
+#include <tuple>
+
+#include "../../include/ext/loguru/loguru.hpp"
+
+#include "../../include/column_generation/espprc_labeling.hpp"
+#include "../../include/instance.hpp"
+#include "../../include/column_generation/column.hpp"
+#include "../../include/utils/constants.hpp"
+
+/* ---------------------------- helper functions  --------------------------- */
+
+namespace
+{
+
+// # of capacity buckets
+const int cNbBuckets = 100;
+
+// # of candidate routes kept (per requested column) while joining labels
+const int cNbCandidatesPerCol = 10;
+
+
+bool test(const std::vector<std::uint64_t>& bitset, const int i)
+{
+    return (bitset[i / 64] >> (i % 64)) & 1;
+}
+
+
+void set(std::vector<std::uint64_t>& bitset, const int i)
+{
+    bitset[i / 64] |= std::uint64_t(1) << (i % 64);
+}
+
+/**
+ * @brief Checks if a is a subset of b.
+ */
+bool isSubset(const std::vector<std::uint64_t>& a,
+              const std::vector<std::uint64_t>& b)
+{
+    for (std::size_t w = 0; w < a.size(); ++w)
+    {
+        if (a[w] & ~b[w])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool areDisjoint(const std::vector<std::uint64_t>& a,
+                 const std::vector<std::uint64_t>& b)
+{
+    for (std::size_t w = 0; w < a.size(); ++w)
+    {
+        if (a[w] & b[w])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool isElementary(const std::vector<int>& route, const int n)
+{
+    std::vector<bool> visited(n, false);
+    for (int v : route)
+    {
+        if (visited[v])
+        {
+            return false;
+        }
+        visited[v] = true;
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+/* -------------------------------------------------------------------------- */
+
+
+EspprcLabeling::EspprcLabeling(const ConfigParameters::cg& params,
+                               const std::shared_ptr<const Instance>& pInst) :
+    mParams(params),
+    mEdgeDuals(pInst->getNbVertices(),
+               std::vector<double>(pInst->getNbVertices(), 0)),
+    mRc(pInst->getNbVertices(), std::vector<double>(pInst->getNbVertices(), 0)),
+    mSrCutsOf(pInst->getNbVertices()),
+    mIsBranchingVertex(pInst->getNbVertices(), false),
+    mForcedPartners(pInst->getNbVertices()),
+    mBuckets(pInst->getNbVertices(),
+             utils::Vec2D<int>(cNbBuckets + 1, std::vector<int>())),
+    mBucketStep(static_cast<double>(pInst->getC()) / cNbBuckets),
+    mRcBound(0),
+    mpInst(pInst)
+{
+    initNgNeighbourhoods();
+}
+
+
+void EspprcLabeling::setBranchingConstrs(
+    const std::vector<BranchingConstr>& constrs)
+{
+    mBranching = constrs;
+    for (const auto& constr : mBranching)
+    {
+        mIsBranchingVertex[constr.i_] = true;
+        mIsBranchingVertex[constr.j_] = true;
+
+        if (constr.edge_ && constr.together_)
+        {
+            mForcedPartners[constr.i_].push_back(constr.j_);
+            mForcedPartners[constr.j_].push_back(constr.i_);
+        }
+    }
+
+    if (!mDuals.empty())
+    {
+        updateReducedCosts(); // forbidden edges
+    }
+}
+
+
+void EspprcLabeling::setDuals(const std::vector<double>& duals)
+{
+    DCHECK_F(static_cast<int>(duals.size()) == mpInst->getNbVertices() + 1);
+
+    mDuals = duals;
+    updateReducedCosts();
+}
+
+
+void EspprcLabeling::setEdgeDuals(const utils::Vec2D<double>& edgeDuals)
+{
+    mEdgeDuals = edgeDuals;
+    if (!mDuals.empty())
+    {
+        updateReducedCosts();
+    }
+}
+
+
+void EspprcLabeling::setSubsetRowDuals(const std::vector<SubsetRowCut>& cuts)
+{
+    mSrCuts = cuts;
+    for (auto& vertexCuts : mSrCutsOf)
+    {
+        vertexCuts.clear();
+    }
+
+    for (int s = 0; s < static_cast<int>(mSrCuts.size()); ++s)
+    {
+        for (int i : mSrCuts[s].set_)
+        {
+            mSrCutsOf[i].push_back(s);
+        }
+    }
+}
+
+
+bool EspprcLabeling::solve()
+{
+    for (;;)
+    {
+        runLabeling();
+        auto best = joinLabels();
+
+        if (!mColumns.empty() || best.empty() ||
+            !augmentNgNeighbourhoods(best))
+        {
+            break;
+        }
+
+        DRAW_LOG_F(INFO, "ESPPRC: ng-neighbourhoods augmented");
+    }
+
+    return true;
+}
+
+
+std::vector<std::pair<Column, double>> EspprcLabeling::extractColumns()
+{
+    return mColumns;
+}
+
+
+double EspprcLabeling::getReducedCostBound() const
+{
+    return mRcBound;
+}
+
+/* ----------------------------- private methods ---------------------------- */
+
+void EspprcLabeling::initNgNeighbourhoods()
+{
+    const int n = mpInst->getNbVertices();
+    const int nbWords = (n + 63) / 64;
+
+    mNg.assign(n, Bitset(nbWords, 0));
+
+    std::vector<int> customers(n - 1);
+    std::iota(std::begin(customers), std::end(customers), 1);
+
+    for (int i = 1; i < n; ++i)
+    {
+        const int size = std::min(mParams.ngSize_, n - 1);
+        std::partial_sort(std::begin(customers),
+                          std::begin(customers) + size,
+                          std::end(customers),
+            [i, this](const int a, const int b)
+            {
+                return mpInst->getcij(i, a) < mpInst->getcij(i, b);
+            });
+
+        set(mNg[i], i);
+        for (int k = 0; k < size; ++k)
+        {
+            set(mNg[i], customers[k]);
+        }
+    }
+}
+
+
+void EspprcLabeling::updateReducedCosts()
+{
+    const int n = mpInst->getNbVertices();
+
+    // the depot prize also includes the dual of the k-routes constraint
+    std::vector<double> prize(std::begin(mDuals), std::begin(mDuals) + n);
+    prize[0] += mDuals[n];
+
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            mRc[i][j] = mpInst->getcij(i, j) - mEdgeDuals[i][j] -
+                        (prize[i] + prize[j]) / 2;
+        }
+    }
+
+    for (const auto& constr : mBranching)
+    {
+        if (constr.edge_ && !constr.together_)
+        {
+            mRc[constr.i_][constr.j_] = mRc[constr.j_][constr.i_] =
+                std::numeric_limits<double>::infinity();
+        }
+    }
+}
+
+
+void EspprcLabeling::runLabeling()
+{
+    const int n = mpInst->getNbVertices();
+    const double cap = mpInst->getC();
+    const int nbWords = (n + 63) / 64;
+    // the branching vertices visited are only tracked under branching
+    const int nbVisitedWords = mBranching.empty() ? 0 : nbWords;
+    const int nbSrWords = (mSrCuts.size() + 63) / 64;
+
+    // the subset-row states and penalty of visiting j
+    auto visit = [this](const int j, Bitset& srState)
+    {
+        double penalty = 0;
+        for (int s : mSrCutsOf[j])
+        {
+            if (test(srState, s))
+            {
+                penalty -= mSrCuts[s].dual_;
+                srState[s / 64] &= ~(std::uint64_t(1) << (s % 64));
+            }
+            else
+            {
+                set(srState, s);
+            }
+        }
+        return penalty;
+    };
+
+    mLabels.clear();
+    for (auto& vertexBuckets : mBuckets)
+    {
+        for (auto& bucket : vertexBuckets)
+        {
+            bucket.clear();
+        }
+    }
+
+    // labels to be extended (by capacity bucket)
+    utils::Vec2D<int> queue(cNbBuckets + 1);
+
+    auto push = [this, &queue](const int l)
+    {
+        if (l >= 0)
+        {
+            const int b = std::min(cNbBuckets,
+                static_cast<int>(mLabels[l].load_ / mBucketStep));
+            queue[b].push_back(l);
+        }
+    };
+
+    // a separate branching constraint forbids the vertices in the route
+    auto isSeparated = [this](const Bitset& visited)
+    {
+        for (const auto& constr : mBranching)
+        {
+            if (!constr.edge_ && !constr.together_ &&
+                test(visited, constr.i_) && test(visited, constr.j_))
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // paths depot -> j
+    for (int j = 1; j < n; ++j)
+    {
+        Bitset visited(nbVisitedWords, 0);
+        const int next = getForcedNext(j, 0, visited);
+        if (mpInst->getdi(j) <= cap && std::isfinite(mRc[0][j]) && next > -2)
+        {
+            Bitset mem(nbWords, 0);
+            set(mem, j);
+            if (mIsBranchingVertex[j])
+            {
+                set(visited, j);
+            }
+            Bitset srState(nbSrWords, 0);
+            visit(j, srState);
+            push(addLabel({j, -1, mRc[0][j], mpInst->getdi(j), mem, visited,
+                           srState, next, false}));
+        }
+    }
+
+    for (int b = 0; b <= cNbBuckets; ++b)
+    {
+        for (std::size_t k = 0; k < queue[b].size(); ++k)
+        {
+            const int l = queue[b][k];
+
+            // bounded labeling: extend only up to half of the capacity
+            if (mLabels[l].dominated_ || mLabels[l].load_ > cap / 2)
+            {
+                continue;
+            }
+
+            const int i = mLabels[l].vertex_;
+            const double cost = mLabels[l].cost_;
+            const double load = mLabels[l].load_;
+            const Bitset mem = mLabels[l].mem_;
+            const Bitset visited = mLabels[l].visited_;
+            const Bitset srState = mLabels[l].srState_;
+            const int forcedNext = mLabels[l].next_;
+
+            for (int j = 1; j < n; ++j)
+            {
+                if (j == i || test(mem, j) ||
+                    load + mpInst->getdi(j) > cap ||
+                    (forcedNext >= 0 && j != forcedNext) ||
+                    !std::isfinite(mRc[i][j]))
+                {
+                    continue;
+                }
+
+                const int next = getForcedNext(j, i, visited);
+                if (next == -2)
+                {
+                    continue;
+                }
+
+                // ng-memory: (mem \cap N_j) \cup {j}
+                Bitset newMem(nbWords, 0);
+                for (int w = 0; w < nbWords; ++w)
+                {
+                    newMem[w] = mem[w] & mNg[j][w];
+                }
+                set(newMem, j);
+
+                Bitset newVisited(visited);
+                if (mIsBranchingVertex[j])
+                {
+                    set(newVisited, j);
+                    if (isSeparated(newVisited))
+                    {
+                        continue;
+                    }
+                }
+
+                Bitset newSrState(srState);
+                const double penalty = visit(j, newSrState);
+
+                push(addLabel({j, l, cost + mRc[i][j] + penalty,
+                               load + mpInst->getdi(j), newMem, newVisited,
+                               newSrState, next, false}));
+            }
+        }
+    }
+}
+
+
+int EspprcLabeling::getForcedNext(const int v,
+                                  const int p,
+                                  const Bitset& visited) const
+{
+    int next = -1;
+    for (int k : mForcedPartners[v])
+    {
+        if (k == p)
+        {
+            continue;
+        }
+
+        // v has one more neighbour and it can not be visited before
+        if (next != -1 || (k > 0 && test(visited, k)))
+        {
+            return -2;
+        }
+        next = k;
+    }
+
+    return next;
+}
+
+
+int EspprcLabeling::addLabel(Label&& label)
+{
+    const int v = label.vertex_;
+    const int b = std::min(cNbBuckets,
+                           static_cast<int>(label.load_ / mBucketStep));
+
+    // dominated by a label with less or equal load
+    for (int bb = 0; bb <= b; ++bb)
+    {
+        for (int l : mBuckets[v][bb])
+        {
+            const auto& other = mLabels[l];
+            if (!other.dominated_ &&
+                other.load_ <= label.load_ &&
+                other.visited_ == label.visited_ &&
+                (other.next_ < 0 || other.next_ == label.next_) &&
+                isSubset(other.mem_, label.mem_) &&
+                other.cost_ + srPenalty(other.srState_, label.srState_) <=
+                    label.cost_)
+            {
+                return -1;
+            }
+        }
+    }
+
+    // labels with greater or equal load dominated by the new label
+    for (int bb = b; bb <= cNbBuckets; ++bb)
+    {
+        for (int l : mBuckets[v][bb])
+        {
+            auto& other = mLabels[l];
+            if (!other.dominated_ &&
+                label.load_ <= other.load_ &&
+                label.visited_ == other.visited_ &&
+                (label.next_ < 0 || label.next_ == other.next_) &&
+                isSubset(label.mem_, other.mem_) &&
+                label.cost_ + srPenalty(label.srState_, other.srState_) <=
+                    other.cost_)
+            {
+                other.dominated_ = true;
+            }
+        }
+    }
+
+    mLabels.push_back(std::move(label));
+    mBuckets[v][b].push_back(mLabels.size() - 1);
+
+    return mLabels.size() - 1;
+}
+
+
+double EspprcLabeling::srPenalty(const Bitset& a, const Bitset& b) const
+{
+    double penalty = 0;
+    for (std::size_t w = 0; w < a.size(); ++w)
+    {
+        for (std::uint64_t bits = a[w] & ~b[w]; bits; bits &= bits - 1)
+        {
+            const int s = 64 * w + std::countr_zero(bits);
+            penalty -= mSrCuts[s].dual_;
+        }
+    }
+
+    return penalty;
+}
+
+
+std::vector<int> EspprcLabeling::joinLabels()
+{
+    const int n = mpInst->getNbVertices();
+    const double cap = mpInst->getC();
+    const int maxNbCandidates = cNbCandidatesPerCol * mParams.maxNbColsPerIter_;
+
+    // non dominated labels of each customer sorted by cost
+    utils::Vec2D<int> labels(n);
+    for (int l = 0; l < static_cast<int>(mLabels.size()); ++l)
+    {
+        if (!mLabels[l].dominated_)
+        {
+            labels[mLabels[l].vertex_].push_back(l);
+        }
+    }
+    for (auto& vertexLabels : labels)
+    {
+        std::sort(std::begin(vertexLabels), std::end(vertexLabels),
+            [this](const int a, const int b)
+            {
+                return mLabels[a].cost_ < mLabels[b].cost_;
+            });
+    }
+
+    // routes (reduced cost, forward label, backward label) with the greatest
+    // reduced cost at the top
+    std::priority_queue<std::tuple<double, int, int>> candidates;
+    std::tuple<double, int, int> best{0, -1, -1};
+
+    auto consider = [&](const double rc, const int l1, const int l2)
+    {
+        if (rc < std::get<0>(best))
+        {
+            best = {rc, l1, l2};
+        }
+
+        if (rc < -utils::GRB_EPSILON)
+        {
+            candidates.push({rc, l1, l2});
+            if (static_cast<int>(candidates.size()) > maxNbCandidates)
+            {
+                candidates.pop();
+            }
+        }
+    };
+
+    // single labels closed at the depot
+    for (int i = 1; i < n; ++i)
+    {
+        for (int l : labels[i])
+        {
+            if (mLabels[l].next_ <= 0 && isCompatible(mLabels[l].visited_))
+            {
+                consider(mLabels[l].cost_ + mRc[i][0], l, -1);
+            }
+        }
+    }
+
+    // forward label at i joined with backward label at j by the edge (i, j)
+    for (int i = 1; i < n; ++i)
+    {
+        for (int j = i + 1; j < n; ++j)
+        {
+            if (labels[i].empty() || labels[j].empty())
+            {
+                continue;
+            }
+
+            const double minCostj = mLabels[labels[j].front()].cost_;
+            for (int l1 : labels[i])
+            {
+                const auto& label1 = mLabels[l1];
+                if (label1.cost_ + mRc[i][j] + minCostj >= 0)
+                {
+                    break;
+                }
+
+                if (label1.next_ >= 0 && label1.next_ != j)
+                {
+                    continue;
+                }
+
+                for (int l2 : labels[j])
+                {
+                    const auto& label2 = mLabels[l2];
+                    double rc = label1.cost_ + mRc[i][j] + label2.cost_;
+                    if (rc >= 0)
+                    {
+                        break;
+                    }
+
+                    if (label1.load_ + label2.load_ > cap ||
+                        (label2.next_ >= 0 && label2.next_ != i) ||
+                        !areDisjoint(label1.mem_, label2.mem_))
+                    {
+                        continue;
+                    }
+
+                    // the cuts with one customer visited by each path
+                    for (std::size_t w = 0; w < label1.srState_.size(); ++w)
+                    {
+                        for (std::uint64_t bits = label1.srState_[w] &
+                                                  label2.srState_[w];
+                             bits; bits &= bits - 1)
+                        {
+                            const int s = 64 * w + std::countr_zero(bits);
+                            rc -= mSrCuts[s].dual_;
+                        }
+                    }
+
+                    if (rc >= 0)
+                    {
+                        continue;
+                    }
+
+                    Bitset visited(label1.visited_);
+                    for (std::size_t w = 0; w < visited.size(); ++w)
+                    {
+                        visited[w] |= label2.visited_[w];
+                    }
+
+                    if (isCompatible(visited))
+                    {
+                        consider(rc, l1, l2);
+                    }
+                }
+            }
+        }
+    }
+
+    // the ng-routes contain all the elementary routes
+    mRcBound = std::get<0>(best);
+
+    auto getRoute = [this](const int l1, const int l2)
+    {
+        auto route = getPath(l1);
+        if (l2 >= 0)
+        {
+            auto path = getPath(l2);
+            route.insert(std::end(route), std::rbegin(path), std::rend(path));
+        }
+        return route;
+    };
+
+    // elementary routes with negative reduced cost
+    std::vector<std::tuple<double, int, int>> sorted;
+    sorted.reserve(candidates.size());
+    for (; !candidates.empty(); candidates.pop())
+    {
+        sorted.push_back(candidates.top());
+    }
+    std::reverse(std::begin(sorted), std::end(sorted));
+
+    mColumns.clear();
+    std::set<std::vector<int>> built; // vertex sets of the columns
+    for (const auto& [pathRc, l1, l2] : sorted)
+    {
+        if (static_cast<int>(mColumns.size()) >= mParams.maxNbColsPerIter_)
+        {
+            break;
+        }
+
+        auto route = getRoute(l1, l2);
+        if (!isElementary(route, n))
+        {
+            continue;
+        }
+
+        Column column(mpInst);
+        column.addVertex(0);
+        double cost = mpInst->getcij(0, route.front()) +
+                      mpInst->getcij(route.back(), 0);
+        for (std::size_t p = 0; p < route.size(); ++p)
+        {
+            column.addVertex(route[p]);
+            if (p > 0)
+            {
+                cost += mpInst->getcij(route[p - 1], route[p]);
+            }
+        }
+        column.setCost(cost);
+
+        std::sort(std::begin(route), std::end(route));
+        if (built.insert(route).second)
+        {
+            double rc = column.getReducedCost(mDuals) -
+                        column.getEdgeSum(mEdgeDuals);
+            for (const auto& cut : mSrCuts)
+            {
+                rc -= cut.dual_ * column.getSubsetRowCoeff(cut.set_);
+            }
+            mColumns.push_back({column, rc});
+        }
+    }
+
+    if (std::get<1>(best) < 0)
+    {
+        return {};
+    }
+
+    return getRoute(std::get<1>(best), std::get<2>(best));
+}
+
+
+bool EspprcLabeling::isCompatible(const Bitset& visited) const
+{
+    for (const auto& constr : mBranching)
+    {
+        if (constr.edge_)
+        {
+            continue;
+        }
+
+        const bool visitsi = test(visited, constr.i_);
+        const bool visitsj = test(visited, constr.j_);
+        if (constr.together_ ? visitsi != visitsj : visitsi && visitsj)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+std::vector<int> EspprcLabeling::getPath(const int l) const
+{
+    std::vector<int> path;
+    for (int p = l; p >= 0; p = mLabels[p].parent_)
+    {
+        path.push_back(mLabels[p].vertex_);
+    }
+    std::reverse(std::begin(path), std::end(path));
+
+    return path;
+}
+
+
+bool EspprcLabeling::augmentNgNeighbourhoods(const std::vector<int>& route)
+{
+    // first cycle of the route: route[p] == route[q], p < q
+    std::vector<int> position(mpInst->getNbVertices(), -1);
+    for (int q = 0; q < static_cast<int>(route.size()); ++q)
+    {
+        const int p = position[route[q]];
+        if (p >= 0)
+        {
+            bool changed = false;
+            for (int k = p + 1; k < q; ++k)
+            {
+                if (!test(mNg[route[k]], route[q]))
+                {
+                    set(mNg[route[k]], route[q]);
+                    changed = true;
+                }
+            }
+            return changed;
+        }
+        position[route[q]] = q;
+    }
+
+    return false;
+}
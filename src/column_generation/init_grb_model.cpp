@@ -10,6 +10,8 @@
  */
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <numeric>
 #include <sstream>
 #include <gurobi_c++.h>
 
@@ -69,10 +71,40 @@ std::vector<GRBVar> init::visitVars(
 
 utils::Vec2D<GRBVar> init::routingVars(
     GRBModel& model,
-    const std::shared_ptr<const Instance>& pInst)
+    const std::shared_ptr<const Instance>& pInst,
+    const int nbNearest)
 {
     DRAW_LOG_F(INFO, "\tInitializing x routing vars...");
 
+    const int n = pInst->getNbVertices();
+
+    // granular edge set: depot edges and k nearest neighbours edges
+    utils::Vec2D<bool> isCreated(n, std::vector<bool>(n, false));
+    std::vector<int> customers(n - 1);
+    std::iota(std::begin(customers), std::end(customers), 1);
+    for (int i = 0; i < n; ++i)
+    {
+        if (i == 0 || nbNearest >= n - 2)
+        {
+            std::fill(std::begin(isCreated[i]), std::end(isCreated[i]), true);
+            continue;
+        }
+
+        std::partial_sort(std::begin(customers),
+                          std::begin(customers) + nbNearest + 1,
+                          std::end(customers),
+            [i, &pInst](const int a, const int b)
+            {
+                return pInst->getcij(i, a) < pInst->getcij(i, b);
+            });
+
+        // the first one may be i itself
+        for (int k = 0; k <= nbNearest; ++k)
+        {
+            isCreated[i][customers[k]] = isCreated[customers[k]][i] = true;
+        }
+    }
+
     utils::Vec2D<GRBVar> x(pInst->getNbVertices(),
                            std::vector<GRBVar>(pInst->getNbVertices()));
 
@@ -80,6 +112,11 @@ utils::Vec2D<GRBVar> init::routingVars(
     {
         for (int j = i + 1; j < pInst->getNbVertices(); ++j)
         {
+            if (!isCreated[i][j])
+            {
+                continue;
+            }
+
             std::ostringstream oss;
             oss << "x_" << i << "_" << j;
             x[i][j] = model.addVar(0,
@@ -141,6 +178,7 @@ void init::kRoutesConstr(GRBModel& model,
 
 
 void init::matchingConstrs(GRBModel& model,
+                           std::vector<GRBConstr>& constrs,
                            const std::vector<GRBVar>& y,
                            const utils::Vec2D<GRBVar>& x,
                            const std::shared_ptr<const Instance>& pInst)
@@ -167,7 +205,7 @@ void init::matchingConstrs(GRBModel& model,
         {
             std::ostringstream oss;
             oss << "C1_" << i;
-            model.addConstr(lhs == 2 * y[i], oss.str());
+            constrs.push_back(model.addConstr(lhs == 2 * y[i], oss.str()));
         }
     }
 }
@@ -21,8 +21,7 @@
 #include "../../include/column_generation/init_pool.hpp"
 #include "../../include/instance.hpp"
 #include "../../include/column_generation/column.hpp"
-#include "../../include/utils/multi_vector.hpp"
-#include "../../include/ext/lkh-2.0.9/lkh_tsp.hpp"
+#include "../../include/column_generation/pricing_heuristic.hpp"
 
 /* ---------------------------- helper functions  --------------------------- */
 
@@ -32,85 +31,6 @@ namespace
 std::random_device gRd;  // will be used to obtain a seed for the rand nb eng
 std::mt19937 gGen(gRd()); // standard mersenne_twister_engine seeded with rd()
 
-
-template<typename T>
-class Vec2dArray
-{
-public:
-
-    Vec2dArray() = delete;
-
-    Vec2dArray(const Vec2dArray& other) = default;
-    Vec2dArray(Vec2dArray&& other) = default;
-    ~Vec2dArray() = default;
-
-    Vec2dArray& operator=(const Vec2dArray& other) = default;
-    Vec2dArray& operator=(Vec2dArray&& other) = default;
-
-    Vec2dArray(const int dim1, const int dim2) :
-        mDim1(dim1),
-        mDim2(dim2),
-        mData(dim1 * dim2)
-    {
-    }
-
-    T& get(const int i, const int j)
-    {
-        DCHECK_F(i >= 0 && i < mDim1);
-        DCHECK_F(j >= 0 && j < mDim2);
-        DCHECK_F(i * mDim1 + j < static_cast<int>(mData.size()));
-        return mData[i * mDim1 + j];
-    }
-
-    const T& get(const int i, const int j) const
-    {
-        DCHECK_F(i >= 0 && i < mDim1);
-        DCHECK_F(j >= 0 && j < mDim2);
-        DCHECK_F(i * mDim1 + j < static_cast<int>(mData.size()));
-        return mData[i * mDim1 + j];
-    }
-
-    T* getData()
-    {
-        return mData.data();
-    }
-
-    int getSize() const
-    {
-        return mData.size();
-    }
-
-private:
-
-    int mDim1;
-    int mDim2;
-    std::vector<T> mData;
-};
-
-
-Vec2dArray<int> genDistMtx(const std::vector<int>::const_iterator& itb,
-                           const std::vector<int>::const_iterator& ite,
-                           const std::shared_ptr<const Instance>& pInst)
-{
-    int size = std::distance(itb, ite);
-    DCHECK_F(size > 0);
-
-    Vec2dArray<int> distMtx(size, size);
-
-    auto iti = itb;
-    for (int i = 0; iti != ite; ++i, ++iti)
-    {
-        auto itj = std::next(iti);
-        for (int j = i + 1; itj != ite; ++j, ++itj)
-        {
-            distMtx.get(i, j) = pInst->getcij(*iti, *itj);
-            distMtx.get(j, i) = pInst->getcij(*iti, *itj);
-        }
-    }
-
-    return distMtx;
-}
-
 } // anonymous namespace
 
 /* -------------------------------------------------------------------------- */
@@ -148,20 +68,13 @@ std::vector<Column> initPool::randomCovers(
                 ++j;
             }
 
-            int cost = 0;
-            if (column.getNbVertices() > 2)
-            {
-                // call LKH algorithm to compute the TSP cost
-                cost = LKH::execute(genDistMtx(
-                    std::begin(column), std::end(column), pInst).getData(),
-                    column.getNbVertices());
-            }
-            else if (column.getNbVertices() == 2) // round trip
-            {
-                cost = 2 * pInst->getcij(0, *std::prev(std::end(column)));
-            }
+            // the sequence of the column is the tour it pays for (the RMP
+            // flows and the capacity cuts coefficients are read from it):
+            // cheapest insertion improved by local search
+            const auto tour = pricingHeur::buildTour(column, pInst);
+            column.setRoute(tour, pricingHeur::tourCost(tour, pInst));
+            pricingHeur::improveRoute(column, pInst);
 
-            column.setCost(cost);
             columns.push_back(column);
         }
     }
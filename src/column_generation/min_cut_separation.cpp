@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: min_cut_separation.cpp
+ *
+ * @brief Exact SEC separation functions definitions.
+ *
+ * Created on October 17, 2026, 11:40 PM
+ *
+ * References:
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "../../include/ext/loguru/loguru.hpp"
+
+#include "../../include/column_generation/min_cut_separation.hpp"
+#include "../../include/instance.hpp"
+#include "../../include/utils/constants.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+
+minCutSep::Workspace::Workspace(const std::shared_ptr<const Instance>& pInst) :
+    pInst_(pInst),
+    maxFlow_(nullptr),
+    cutValue_(pInst->getNbVertices() + 1, 0),
+    nextOnPath_(pInst->getNbVertices() + 1, 0),
+    shores_(pInst->getNbVertices() + 1),
+    maxY_(pInst->getNbVertices() + 1, 0)
+{
+    const int n = pInst->getNbVertices();
+    vertexOf_.reserve(n + 1);
+    MXF_InitMem(&maxFlow_, n, n * (n - 1));
+}
+
+
+minCutSep::Workspace::~Workspace()
+{
+    MXF_FreeMem(maxFlow_);
+}
+
+
+int minCutSep::separateSecs(const utils::Vec2D<double>& xVal,
+                            const std::vector<double>& yVal,
+                            const int maxNbSets,
+                            const double minViolation,
+                            Workspace& ws,
+                            utils::Vec2D<int>& sets)
+{
+    int nbSets = 0;
+
+    // network of the depot (node 1) and the visited customers: the other
+    // customers have no edge in the support graph
+    const int n = ws.pInst_->getNbVertices();
+    ws.vertexOf_.assign({-1, 0});
+    for (int v = 1; v < n; ++v)
+    {
+        if (yVal[v] > utils::GRB_EPSILON)
+        {
+            ws.vertexOf_.push_back(v);
+        }
+    }
+
+    const int nbNodes = ws.vertexOf_.size() - 1;
+    if (nbNodes < 2)
+    {
+        return nbSets;
+    }
+
+    MXF_ClearNodeList(ws.maxFlow_);
+    MXF_SetNodeListSize(ws.maxFlow_, nbNodes);
+    MXF_ClearArcList(ws.maxFlow_);
+    for (int p = 1; p <= nbNodes; ++p)
+    {
+        for (int q = p + 1; q <= nbNodes; ++q)
+        {
+            const double x = xVal[ws.vertexOf_[p]][ws.vertexOf_[q]];
+            if (x > utils::GRB_EPSILON)
+            {
+                MXF_AddArc(ws.maxFlow_, p, q, x);
+                MXF_AddArc(ws.maxFlow_, q, p, x);
+            }
+        }
+    }
+    MXF_CreateMates(ws.maxFlow_);
+
+    MXF_ComputeGHCutTree(ws.maxFlow_, 1, ws.cutValue_.data(),
+                         ws.nextOnPath_.data());
+
+    // shore of the tree edge of each node: the customers of its subtree
+    for (int u = 2; u <= nbNodes; ++u)
+    {
+        ws.shores_[u].clear();
+        ws.maxY_[u] = 0;
+    }
+    for (int w = 2; w <= nbNodes; ++w)
+    {
+        const int v = ws.vertexOf_[w];
+        for (int u = w; u != 1; u = ws.nextOnPath_[u])
+        {
+            DCHECK_F(1 <= u && u <= nbNodes);
+            ws.shores_[u].push_back(v);
+            ws.maxY_[u] = std::max(ws.maxY_[u], yVal[v]);
+        }
+    }
+
+    // SEC of the greatest y_i of each shore: y_i - x(delta(S)) / 2
+    auto& violated = ws.violated_;
+    violated.clear();
+    for (int u = 2; u <= nbNodes; ++u)
+    {
+        const double violation = ws.maxY_[u] - ws.cutValue_[u] / 2;
+        if (violation > minViolation)
+        {
+            violated.push_back({violation, u});
+        }
+    }
+
+    std::sort(std::begin(violated), std::end(violated),
+        [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    for (const auto& [violation, u] : violated)
+    {
+        if (nbSets >= maxNbSets)
+        {
+            break;
+        }
+        if (nbSets == static_cast<int>(sets.size()))
+        {
+            sets.emplace_back();
+        }
+        auto& set = sets[nbSets++];
+        set.assign(std::begin(ws.shores_[u]), std::end(ws.shores_[u]));
+        std::sort(std::begin(set), std::end(set));
+    }
+
+    return nbSets;
+}
@@ -22,6 +22,14 @@
  */
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <sstream>
+
 #include "../../include/ext/loguru/loguru.hpp"
 
 #include "../../include/column_generation/pctsp_ilp.hpp"
@@ -29,6 +37,7 @@
 #include "../../include/column_generation/callback_sec.hpp"
 #include "../../include/column_generation/column.hpp"
 #include "../../include/column_generation/init_grb_model.hpp"
+#include "../../include/column_generation/pricing_heuristic.hpp"
 #include "../../include/column_generation/set_covering_lp.hpp"
 #include "../../include/utils/constants.hpp"
 #include "../../include/utils/tools.hpp"
@@ -41,14 +50,40 @@ namespace
 
 const std::string cBaseName = "tsp_bcsl_";
 
+// maximum # of MIP start solutions
+const int cMaxNbStarts = 5;
+
+/**
+ * @brief Warns (once per run) that the models are forced to a single thread
+ * by the node state of the callback.
+ */
+void warnSingleThread()
+{
+    static std::once_flag flag;
+    std::call_once(flag, []()
+        {
+            RAW_LOG_F(WARNING, "PCTSP: the per-node cuts limit or the "
+                "tailing off detection forces the pricing MIP to one thread "
+                "(set cg_sep_max_cuts_per_node and cg_sep_tailing_off_rounds "
+                "to 0 to use solver_nb_threads)");
+        });
+}
+
 }
 
 /* -------------------------------------------------------------------------- */
 
 
-PctspIlp::PctspIlp(const std::shared_ptr<SetCoveringLp>& pRMP,
+PctspIlp::PctspIlp(const ConfigParameters::cg& params,
+                   const std::shared_ptr<SetCoveringLp>& pRMP,
                    const std::shared_ptr<const Instance>& pInst) :
     BaseLp(pRMP->getGRBEnv(), pInst),
+    mParams(params),
+    mKDual(0),
+    mPrizes(pInst->getNbVertices(), 0),
+    mExcludedEdgesBound(std::numeric_limits<double>::infinity()),
+    mIsFixed(pInst->getNbVertices(), false),
+    mFixedVisitsBound(std::numeric_limits<double>::infinity()),
     mpRMP(pRMP),
     mpCb(nullptr)
 {
@@ -56,57 +91,467 @@ PctspIlp::PctspIlp(const std::shared_ptr<SetCoveringLp>& pRMP,
 }
 
 
-std::pair<Column, double> PctspIlp::extractColumn() const
+PctspIlp::PctspIlp(const ConfigParameters::cg& params,
+                   const int seed,
+                   const std::shared_ptr<const Instance>& pInst) :
+    BaseLp(pInst),
+    mParams(params),
+    mKDual(0),
+    mPrizes(pInst->getNbVertices(), 0),
+    mExcludedEdgesBound(std::numeric_limits<double>::infinity()),
+    mIsFixed(pInst->getNbVertices(), false),
+    mFixedVisitsBound(std::numeric_limits<double>::infinity()),
+    mpRMP(nullptr),
+    mpCb(nullptr)
 {
-    double rc = 0;
-    Column column(mpInst);
+    initModel();
 
     try
     {
-        rc -= mpRMP->getDual(mpInst->getNbVertices()); // |V| constraint dual
-        rc += mModel.get(GRB_DoubleAttr_ObjVal);
+        mModel.set(GRB_IntParam_Seed, seed);
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::PctspIlp(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::PctspIlp(): Unknown Exception");
+    }
+}
 
-        if (rc < 0)
+
+void PctspIlp::setBranchingConstrs(const std::vector<BranchingConstr>& constrs)
+{
+    mBranching = constrs;
+
+    try
+    {
+        for (const auto& constr : constrs)
         {
-            double cost = mModel.get(GRB_DoubleAttr_ObjVal);
-            for (int i = 0; i < mpInst->getNbVertices(); ++i)
+            std::ostringstream oss;
+            oss << "BR_" << constr.i_ << "_" << constr.j_;
+            if (constr.edge_)
             {
-                if (utils::tools::varExists(m_y[i]) &&
-                    m_y[i].get(GRB_DoubleAttr_X) > utils::GRB_EPSILON)
+                // the edge var must exist (and it is not added later)
+                if (!utils::tools::varExists(m_x[constr.i_][constr.j_]))
+                {
+                    DCHECK_F(constr.i_ > 0);
+                    addEdge(constr.i_, constr.j_);
+                }
+
+                const auto& x = m_x[constr.i_][constr.j_];
+                if (!constr.together_)
                 {
-                    column.addVertex(i);
-                    cost -= m_y[i].get(GRB_DoubleAttr_Obj);
+                    mModel.addConstr(x <= 0, oss.str());
+                }
+                else
+                {
+                    mModel.addConstr(x >= m_y[constr.j_], oss.str() + "_j");
+                    if (constr.i_ > 0)
+                    {
+                        mModel.addConstr(x >= m_y[constr.i_],
+                                         oss.str() + "_i");
+                    }
                 }
             }
+            else if (constr.together_)
+            {
+                mModel.addConstr(m_y[constr.i_] == m_y[constr.j_], oss.str());
+            }
+            else
+            {
+                mModel.addConstr(m_y[constr.i_] + m_y[constr.j_] <= 1,
+                                 oss.str());
+            }
+        }
 
-            column.setCost(cost);
+        mModel.update();
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::setBranchingConstrs(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::setBranchingConstrs(): Unknown Exception");
+    }
+
+    // the forbidden edges can not be shortcuts
+    updateEdgeBounds();
+}
+
+
+void PctspIlp::setDuals(const std::vector<double>& duals)
+{
+    updateVisitVarsObjCoeff(duals);
+}
+
+
+void PctspIlp::setEdgeDuals(const utils::Vec2D<double>& edgeDuals)
+{
+    const int n = mpInst->getNbVertices();
+
+    bool changed = false;
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            const double cost = mpInst->getcij(i, j) - edgeDuals[i][j];
+            changed = changed || cost != mEdgeCosts[i][j];
+            mEdgeCosts[i][j] = cost;
+        }
+    }
+
+    if (!changed)
+    {
+        return;
+    }
+
+    try
+    {
+        std::vector<GRBVar> x;
+        std::vector<double> obj;
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = i + 1; j < n; ++j)
+            {
+                if (utils::tools::varExists(m_x[i][j]))
+                {
+                    x.push_back(m_x[i][j]);
+                    obj.push_back(mEdgeCosts[i][j]);
+                }
+            }
+        }
+        setObj(x, obj);
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::setEdgeDuals(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::setEdgeDuals(): Unknown Exception");
+    }
+
+    updateEdgeBounds();
+}
+
+
+void PctspIlp::setSubsetRowDuals(const std::vector<SubsetRowCut>& cuts)
+{
+    const bool sameSets = std::equal(std::begin(cuts), std::end(cuts),
+                                     std::begin(mSrCuts), std::end(mSrCuts),
+        [](const SubsetRowCut& a, const SubsetRowCut& b)
+        {
+            return a.set_ == b.set_;
+        });
+
+    try
+    {
+        std::vector<double> penalties(cuts.size());
+        std::transform(std::begin(cuts), std::end(cuts), std::begin(penalties),
+            [](const SubsetRowCut& cut) { return -cut.dual_; });
+
+        if (sameSets)
+        {
+            setObj(m_w, penalties);
+        }
+        else
+        {
+            for (std::size_t s = 0; s < m_w.size(); ++s)
+            {
+                mModel.remove(mSrConstrs[s]);
+                mModel.remove(m_w[s]);
+            }
+            m_w.clear();
+            mSrConstrs.clear();
+
+            for (std::size_t s = 0; s < cuts.size(); ++s)
+            {
+                const auto& [a, b, c] = cuts[s].set_;
+                std::ostringstream oss;
+                oss << "w_" << a << "_" << b << "_" << c;
+                m_w.push_back(mModel.addVar(0, 1, penalties[s], GRB_BINARY,
+                                            oss.str()));
+                mSrConstrs.push_back(mModel.addConstr(
+                    m_y[a] + m_y[b] + m_y[c] - 2 * m_w.back() <= 1,
+                    "SR" + oss.str().substr(1)));
+            }
+            mModel.update();
+        }
+
+        mSrCuts = cuts;
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::setSubsetRowDuals(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::setSubsetRowDuals(): Unknown Exception");
+    }
+}
+
+
+void PctspIlp::setStartColumns(const std::vector<Column>& columns)
+{
+    mStartColumns = columns;
+}
+
+
+void PctspIlp::setNbThreads(const int nbThreads)
+{
+    try
+    {
+        // the callback identifies the nodes by their count
+        if (mpCb->keepsNodeState())
+        {
+            if (nbThreads != 1)
+            {
+                warnSingleThread();
+            }
+            mModel.set(GRB_IntParam_Threads, 1);
+        }
+        else
+        {
+            mModel.set(GRB_IntParam_Threads, nbThreads);
         }
     }
     catch (GRBException& e)
     {
-        RAW_LOG_F(FATAL, "PctspIlp::extractColumn(): C-Exp: %s",
+        RAW_LOG_F(FATAL, "PctspIlp::setNbThreads(): C-Exp: %s",
             e.getMessage().c_str());
     }
     catch (...)
     {
-        RAW_LOG_F(FATAL, "PctspIlp::extractColumn(): Unknown Exception");
+        RAW_LOG_F(FATAL, "PctspIlp::setNbThreads(): Unknown Exception");
     }
+}
+
+
+bool PctspIlp::solve()
+{
+    setStarts();
+
+    for (;;)
+    {
+        installPendingCuts();
+        mpCb->initOptimization();
+
+        if (!optimize())
+        {
+            return false;
+        }
+
+        // node count buckets [2^b - 1, 2^(b+1) - 1)
+        const auto& nodeCountStats = mpCb->getNodeCountStats();
+        for (std::size_t b = 0; b < nodeCountStats.size(); ++b)
+        {
+            DRAW_LOG_F(INFO,
+                "PCTSP: nodes %d-%d: %d rounds, %d cuts, gain %.2f",
+                (1 << b) - 1, (1 << (b + 1)) - 2, nodeCountStats[b].nbRounds_,
+                nodeCountStats[b].nbCuts_, nodeCountStats[b].gain_);
+        }
 
-    return {column, rc};
+        updateCutPool();
+
+        const int nbAdded = addImprovingEdges();
+        if (nbAdded == 0)
+        {
+            return true;
+        }
+
+        DRAW_LOG_F(INFO, "PCTSP: %d edges added, solving again", nbAdded);
+    }
 }
 
 
-void PctspIlp::updateVisitVarsObjCoeff()
+std::vector<std::pair<Column, double>> PctspIlp::extractColumns()
 {
+    std::vector<std::pair<Column, double>> columns;
+
     try
     {
-        for (int i = 1; i < mpInst->getNbVertices(); ++i) // skip depot
+        const int nbSols = mModel.get(GRB_IntAttr_SolCount);
+
+        // vertex sets of the columns already extracted
+        std::set<std::vector<int>> extracted;
+
+        // objective coefficients of the y vars (the prizes)
+        const auto obj = getValues(m_y, GRB_DoubleAttr_Obj);
+
+        // edges in the model
+        const int n = mpInst->getNbVertices();
+        std::vector<GRBVar> x;
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 0; i < n; ++i)
         {
-            if (utils::tools::varExists(m_y[i]))
+            for (int j = i + 1; j < n; ++j)
             {
-                m_y[i].set(GRB_DoubleAttr_Obj, -mpRMP->getDual(i));
+                if (utils::tools::varExists(m_x[i][j]))
+                {
+                    x.push_back(m_x[i][j]);
+                    edges.push_back({i, j});
+                }
             }
         }
+
+        // the pool solutions are sorted by objective value (best first)
+        for (int s = 0; s < nbSols &&
+             static_cast<int>(columns.size()) < mParams.maxNbColsPerIter_; ++s)
+        {
+            mModel.set(GRB_IntParam_SolutionNumber, s);
+
+            const double objVal = mModel.get(GRB_DoubleAttr_PoolObjVal);
+            const double rc = objVal - mKDual;
+
+            if (rc >= -utils::GRB_EPSILON)
+            {
+                break;
+            }
+
+            const auto y = getValues(m_y, GRB_DoubleAttr_Xn);
+            const auto xVal = getValues(x, GRB_DoubleAttr_Xn);
+
+            // the vertices are added in the tour order (from the depot)
+            utils::Vec2D<int> adj(n);
+            for (std::size_t e = 0; e < edges.size(); ++e)
+            {
+                if (xVal[e] > 0.5)
+                {
+                    adj[edges[e].first].push_back(edges[e].second);
+                    adj[edges[e].second].push_back(edges[e].first);
+                }
+            }
+
+            Column column(mpInst);
+            column.addVertex(0);
+            for (int v = 0, next = 0; next >= 0; v = next)
+            {
+                next = -1;
+                for (int u : adj[v])
+                {
+                    if (!column.contains(u))
+                    {
+                        next = u;
+                        column.addVertex(u);
+                        break;
+                    }
+                }
+            }
+
+            // the edge duals and the subset-row penalties are not part of
+            // the cost
+            double cost = objVal;
+            for (std::size_t e = 0; e < edges.size(); ++e)
+            {
+                const auto [i, j] = edges[e];
+                cost += std::round(xVal[e]) *
+                        (mpInst->getcij(i, j) - mEdgeCosts[i][j]);
+            }
+
+            const auto w = getValues(m_w, GRB_DoubleAttr_Xn);
+            for (std::size_t s = 0; s < w.size(); ++s)
+            {
+                cost += std::round(w[s]) * mSrCuts[s].dual_;
+            }
+
+            std::vector<int> vertices;
+            for (int i = 0; i < n; ++i)
+            {
+                if (y[i] > utils::GRB_EPSILON)
+                {
+                    column.addVertex(i); // only if out of the tour
+                    vertices.push_back(i);
+                    cost -= obj[i];
+                }
+            }
+
+            if (extracted.insert(vertices).second)
+            {
+                column.setCost(cost);
+                columns.push_back({column, rc});
+            }
+        }
+
+        mLastColumns.clear();
+        for (const auto& [column, rc] : columns)
+        {
+            mLastColumns.push_back(column);
+        }
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::extractColumns(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::extractColumns(): Unknown Exception");
+    }
+
+    return columns;
+}
+
+
+double PctspIlp::getReducedCostBound() const
+{
+    double bound = 0;
+
+    try
+    {
+        // cut off: no solution better than the cutoff (mKDual) exists
+        const double objBound = mStatus == GRB_CUTOFF ?
+            mKDual : mModel.get(GRB_DoubleAttr_ObjBound);
+        bound = std::min({objBound, mExcludedEdgesBound, mFixedVisitsBound}) -
+                mKDual;
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::getReducedCostBound(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::getReducedCostBound(): Unknown Exception");
+    }
+
+    return bound;
+}
+
+
+void PctspIlp::updateVisitVarsObjCoeff(const std::vector<double>& duals)
+{
+    DCHECK_F(static_cast<int>(duals.size()) == mpInst->getNbVertices() + 1);
+
+    try
+    {
+        // y_0 is fixed to 1, so its coeff only adds the depot covering dual
+        std::vector<double> obj(mpInst->getNbVertices());
+        std::transform(std::begin(duals), std::begin(duals) + obj.size(),
+                       std::begin(obj), std::negate<double>());
+        setObj(m_y, obj);
+
+        std::copy(std::begin(duals), std::begin(duals) + mPrizes.size(),
+                  std::begin(mPrizes));
+
+        mKDual = duals[mpInst->getNbVertices()];
+
+        fixUnprofitableCustomers();
+
+        // early exit: only the solutions with negative reduced cost matter
+        // and the first one with reduced cost <= -cg_early_exit_rc is enough
+        if (mParams.earlyExitPricing_)
+        {
+            mModel.set(GRB_DoubleParam_Cutoff, mKDual);
+            mModel.set(GRB_DoubleParam_BestObjStop,
+                       mKDual - mParams.earlyExitRc_);
+        }
     }
     catch (GRBException& e)
     {
@@ -132,20 +577,30 @@ void PctspIlp::initModel()
         mModel.set(GRB_StringAttr_ModelName, modelName);
 
         // variables
-        m_x = init::routingVars(mModel, mpInst);
+        m_x = init::routingVars(mModel, mpInst, mParams.nbNearestEdges_);
         m_y = init::visitVars(mModel, mpInst);
 
         // constraints
-        init::matchingConstrs(mModel, m_y, m_x, mpInst);
+        init::matchingConstrs(mModel, mMatchingConstrs, m_y, m_x, mpInst);
         init::capacityConstr(mModel, m_y, mpInst);
 
+        // keep enough solutions to extract several columns per iteration
+        mModel.set(GRB_IntParam_PoolSolutions, mParams.maxNbColsPerIter_);
+
         // setup CVRPSEP callback
         mModel.set(GRB_IntParam_LazyConstraints, 1); // see [3]
         mModel.set(GRB_IntParam_PreCrush, 1); // see [4]
 
-        mpCb = std::make_shared<CallbackSEC>(m_x, m_y, mpInst);
+        mpCb = std::make_shared<CallbackSEC>(mParams, m_x, m_y, mpInst);
         mModel.setCallback(mpCb.get());
 
+        // the callback identifies the nodes by their count
+        if (mpCb->keepsNodeState())
+        {
+            warnSingleThread();
+            mModel.set(GRB_IntParam_Threads, 1);
+        }
+
         mModel.update();
     }
     catch (GRBException& e)
@@ -157,4 +612,511 @@ void PctspIlp::initModel()
     {
         RAW_LOG_F(FATAL, "PctspIlp::initModel(): Unknown Exception");
     }
+
+    const int n = mpInst->getNbVertices();
+    mEdgeCosts.assign(n, std::vector<double>(n, 0));
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            mEdgeCosts[i][j] = mpInst->getcij(i, j);
+        }
+    }
+
+    updateEdgeBounds();
+}
+
+
+void PctspIlp::updateEdgeBounds()
+{
+    // the two least cost edges of each vertex (over all the edges)
+    const int n = mpInst->getNbVertices();
+    mCheapestEdges.assign(n, {std::numeric_limits<double>::infinity(),
+                              std::numeric_limits<double>::infinity(), -1});
+    for (int i = 0; i < n; ++i)
+    {
+        auto& [c1, c2, k] = mCheapestEdges[i];
+        for (int j = 0; j < n; ++j)
+        {
+            const double cost = mEdgeCosts[i][j];
+            if (j == i)
+            {
+                continue;
+            }
+            else if (cost < c1)
+            {
+                c2 = c1;
+                c1 = cost;
+                k = j;
+            }
+            else if (cost < c2)
+            {
+                c2 = cost;
+            }
+        }
+    }
+
+    // edges forbidden by the branching (their x vars are bounded by
+    // constraints, so their costs are the ones of the other edges)
+    std::vector<std::vector<bool>> isForbidden(n, std::vector<bool>(n, false));
+    for (const auto& constr : mBranching)
+    {
+        if (constr.edge_ && !constr.together_)
+        {
+            isForbidden[constr.i_][constr.j_] = true;
+            isForbidden[constr.j_][constr.i_] = true;
+        }
+    }
+
+    // the least detour of each customer (between two distinct vertices): a
+    // shortcut by a forbidden edge costs +infinity, so the detour is
+    // unbounded below (the route without the customer is not feasible)
+    mMinDetours.assign(n, std::numeric_limits<double>::infinity());
+    for (int i = 1; i < n; ++i)
+    {
+        for (int a = 0; a < n; ++a)
+        {
+            for (int b = a + 1; b < n; ++b)
+            {
+                if (a == i || b == i)
+                {
+                    continue;
+                }
+                else if (isForbidden[a][b])
+                {
+                    mMinDetours[i] = -std::numeric_limits<double>::infinity();
+                }
+                else
+                {
+                    mMinDetours[i] = std::min(mMinDetours[i],
+                        mEdgeCosts[a][i] + mEdgeCosts[i][b] -
+                        mEdgeCosts[a][b]);
+                }
+            }
+        }
+    }
+}
+
+
+int PctspIlp::addImprovingEdges()
+{
+    const int n = mpInst->getNbVertices();
+    int nbAdded = 0;
+
+    try
+    {
+        // solutions worse than the last one (or without negative reduced
+        // cost) do not matter
+        double threshold = mKDual;
+        if (mStatus == GRB_USER_OBJ_LIMIT)
+        {
+            // early exit: the columns found are enough (no edge is added)
+            threshold = -std::numeric_limits<double>::infinity();
+        }
+        else if (mModel.get(GRB_IntAttr_SolCount) > 0)
+        {
+            threshold = std::min(threshold, mModel.get(GRB_DoubleAttr_ObjVal));
+        }
+
+        // least contribution of each vertex: half of its two edges minus its
+        // prize (customers are optional, so only negative ones count)
+        std::vector<double> contrib(n);
+        double sumNeg = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            const auto& [c1, c2, k] = mCheapestEdges[i];
+            contrib[i] = (c1 + c2) / 2 - mPrizes[i];
+            if (i > 0)
+            {
+                sumNeg += std::min(0.0, contrib[i]);
+            }
+        }
+
+        // contribution of a vertex using the edge (i, j)
+        auto edgeContrib = [this](const int i, const int j)
+        {
+            const auto& [c1, c2, k] = mCheapestEdges[i];
+            return (mEdgeCosts[i][j] + (k == j ? c2 : c1)) / 2 -
+                   mPrizes[i];
+        };
+
+        mExcludedEdgesBound = std::numeric_limits<double>::infinity();
+        for (int i = 1; i < n; ++i)
+        {
+            for (int j = i + 1; j < n; ++j)
+            {
+                // the routes of fixed customers are dominated (no customer is
+                // fixed while an edge is forbidden, see updateEdgeBounds)
+                if (utils::tools::varExists(m_x[i][j]) ||
+                    mIsFixed[i] || mIsFixed[j])
+                {
+                    continue;
+                }
+
+                const double bound = contrib[0] + sumNeg -
+                    std::min(0.0, contrib[i]) - std::min(0.0, contrib[j]) +
+                    edgeContrib(i, j) + edgeContrib(j, i);
+
+                if (bound < threshold - utils::GRB_EPSILON)
+                {
+                    addEdge(i, j);
+                    ++nbAdded;
+                }
+                else
+                {
+                    mExcludedEdgesBound = std::min(mExcludedEdgesBound, bound);
+                }
+            }
+        }
+
+        if (nbAdded > 0)
+        {
+            mModel.update();
+        }
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::addImprovingEdges(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::addImprovingEdges(): Unknown Exception");
+    }
+
+    return nbAdded;
+}
+
+
+void PctspIlp::setStarts()
+{
+    const int n = mpInst->getNbVertices();
+
+    // candidates sorted by reduced cost at the current prizes
+    std::vector<double> duals(mPrizes);
+    duals.push_back(mKDual);
+
+    std::vector<std::pair<double, const Column*>> candidates;
+    for (const auto* pColumns : {&mStartColumns, &mLastColumns})
+    {
+        for (const auto& column : *pColumns)
+        {
+            if (column.getDemand() <= mpInst->getC() &&
+                column.isCompatible(mBranching) &&
+                std::none_of(std::begin(column), std::end(column),
+                    [this](const int i) { return mIsFixed[i]; }))
+            {
+                candidates.push_back({column.getReducedCost(duals), &column});
+            }
+        }
+    }
+    std::sort(std::begin(candidates), std::end(candidates),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+    if (static_cast<int>(candidates.size()) > cMaxNbStarts)
+    {
+        candidates.resize(cMaxNbStarts);
+    }
+
+    try
+    {
+        // tours of the starts (the edges out of the model are added)
+        std::vector<std::vector<int>> tours;
+        for (const auto& [rc, pColumn] : candidates)
+        {
+            tours.push_back(pricingHeur::buildTour(*pColumn, mpInst));
+            const auto& tour = tours.back();
+            for (std::size_t p = 0; p < tour.size(); ++p)
+            {
+                const int a = std::min(tour[p], tour[(p + 1) % tour.size()]);
+                const int b = std::max(tour[p], tour[(p + 1) % tour.size()]);
+                if (a != b && !utils::tools::varExists(m_x[a][b]))
+                {
+                    addEdge(a, b);
+                }
+            }
+        }
+        mModel.update();
+
+        std::vector<GRBVar> x;
+        utils::Vec2D<int> edgeIdx(n, std::vector<int>(n, -1));
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = i + 1; j < n; ++j)
+            {
+                if (utils::tools::varExists(m_x[i][j]))
+                {
+                    edgeIdx[i][j] = x.size();
+                    x.push_back(m_x[i][j]);
+                }
+            }
+        }
+
+        mModel.set(GRB_IntAttr_NumStart, static_cast<int>(tours.size()));
+        for (int s = 0; s < static_cast<int>(tours.size()); ++s)
+        {
+            const auto& tour = tours[s];
+            std::vector<double> yStart(n, 0);
+            std::vector<double> xStart(x.size(), 0);
+            for (std::size_t p = 0; p < tour.size(); ++p)
+            {
+                const int a = std::min(tour[p], tour[(p + 1) % tour.size()]);
+                const int b = std::max(tour[p], tour[(p + 1) % tour.size()]);
+                yStart[tour[p]] = 1;
+                if (a != b)
+                {
+                    xStart[edgeIdx[a][b]] += 1;
+                }
+            }
+
+            mModel.set(GRB_IntParam_StartNumber, s);
+            mModel.set(GRB_DoubleAttr_Start, m_y.data(), yStart.data(), n);
+            mModel.set(GRB_DoubleAttr_Start, x.data(), xStart.data(),
+                       x.size());
+        }
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::setStarts(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::setStarts(): Unknown Exception");
+    }
+}
+
+
+void PctspIlp::addEdge(const int i, const int j)
+{
+    DCHECK_F(0 < i && i < j);
+
+    GRBColumn column;
+    column.addTerm(1, mMatchingConstrs[i]);
+    column.addTerm(1, mMatchingConstrs[j]);
+
+    // the edge is in E(S) of the pool cuts with both end points in S
+    for (const auto& cut : mCutPool)
+    {
+        if (std::binary_search(std::begin(cut.set_), std::end(cut.set_), i) &&
+            std::binary_search(std::begin(cut.set_), std::end(cut.set_), j))
+        {
+            for (const auto& constr : cut.constrs_)
+            {
+                column.addTerm(1, constr);
+            }
+        }
+    }
+
+    std::ostringstream oss;
+    oss << "x_" << i << "_" << j;
+    m_x[i][j] = mModel.addVar(0, 1, mEdgeCosts[i][j], GRB_BINARY, column,
+                              oss.str());
+}
+
+
+void PctspIlp::updateCutPool()
+{
+    if (mParams.cutPoolSize_ == 0)
+    {
+        mpCb->extractSeparatedSets(); // the pool is disabled
+        return;
+    }
+
+    try
+    {
+        if (!mCutPool.empty() && mModel.get(GRB_IntAttr_SolCount) > 0)
+        {
+            std::vector<GRBConstr> constrs;
+            for (const auto& cut : mCutPool)
+            {
+                constrs.insert(std::end(constrs), std::begin(cut.constrs_),
+                               std::end(cut.constrs_));
+            }
+            const auto slack = getValues(constrs, GRB_DoubleAttr_Slack);
+            const auto y = getValues(m_y);
+
+            // a cut is tight if the constraint of a visited customer is tight
+            // (the constraints of unvisited sets are trivially tight)
+            std::size_t k = 0;
+            for (auto& cut : mCutPool)
+            {
+                bool active = false;
+                for (int i : cut.set_)
+                {
+                    active = active || (y[i] > utils::GRB_EPSILON &&
+                                        slack[k] <= utils::GRB_EPSILON);
+                    ++k;
+                }
+
+                if (active)
+                {
+                    ++cut.nbActive_;
+                    cut.age_ = 0;
+                }
+                else
+                {
+                    ++cut.age_;
+                }
+            }
+        }
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::updateCutPool(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::updateCutPool(): Unknown Exception");
+    }
+
+    for (auto& set : mpCb->extractSeparatedSets())
+    {
+        if (mCutPoolSets.insert(set).second)
+        {
+            mPendingCuts.push_back(std::move(set));
+        }
+    }
+}
+
+
+void PctspIlp::installPendingCuts()
+{
+    try
+    {
+        for (auto& set : mPendingCuts)
+        {
+            installCut(std::move(set));
+        }
+        mPendingCuts.clear();
+
+        if (static_cast<int>(mCutPool.size()) > mParams.cutPoolSize_)
+        {
+            // most recently (and most often) tight cuts first
+            std::stable_sort(std::begin(mCutPool), std::end(mCutPool),
+                [](const PoolCut& a, const PoolCut& b)
+                {
+                    return a.age_ < b.age_ ||
+                           (a.age_ == b.age_ && a.nbActive_ > b.nbActive_);
+                });
+
+            for (std::size_t c = mParams.cutPoolSize_; c < mCutPool.size(); ++c)
+            {
+                for (auto& constr : mCutPool[c].constrs_)
+                {
+                    mModel.remove(constr);
+                }
+                mCutPoolSets.erase(mCutPool[c].set_);
+            }
+            mCutPool.erase(std::begin(mCutPool) + mParams.cutPoolSize_,
+                           std::end(mCutPool));
+        }
+
+        mModel.update();
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::installPendingCuts(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "PctspIlp::installPendingCuts(): Unknown Exception");
+    }
+}
+
+
+void PctspIlp::installCut(std::vector<int>&& set)
+{
+    GRBLinExpr xExpr = 0, yExpr = 0;
+    for (std::size_t a = 0; a < set.size(); ++a)
+    {
+        for (std::size_t b = a + 1; b < set.size(); ++b)
+        {
+            if (utils::tools::varExists(m_x[set[a]][set[b]]))
+            {
+                xExpr += m_x[set[a]][set[b]];
+            }
+        }
+        yExpr += m_y[set[a]];
+    }
+
+    PoolCut cut{std::move(set), {}, 0, 0};
+    cut.constrs_.reserve(cut.set_.size());
+    for (int i : cut.set_)
+    {
+        cut.constrs_.push_back(mModel.addConstr(xExpr <= yExpr - m_y[i]));
+    }
+
+    mCutPool.push_back(std::move(cut));
+}
+
+
+void PctspIlp::fixUnprofitableCustomers()
+{
+    const int n = mpInst->getNbVertices();
+
+    std::vector<bool> isBranchingVertex(n, false);
+    for (const auto& constr : mBranching)
+    {
+        isBranchingVertex[constr.i_] = isBranchingVertex[constr.j_] = true;
+    }
+
+    // a route with a fixed customer and other customers is dominated by the
+    // one without it and a route with only fixed customers by the single
+    // customer route of one of them (without negative reduced cost)
+    std::vector<double> singleObj(n, std::numeric_limits<double>::infinity());
+    int nbFixed = 0;
+    for (int i = 1; i < n; ++i)
+    {
+        singleObj[i] = 2 * mEdgeCosts[0][i] - mPrizes[0] - mPrizes[i];
+        mIsFixed[i] = !isBranchingVertex[i] &&
+                      mPrizes[i] <= mMinDetours[i] &&
+                      singleObj[i] >= mKDual;
+        nbFixed += mIsFixed[i];
+    }
+
+    // the model needs at least one customer to be feasible
+    if (nbFixed == n - 1)
+    {
+        const auto it = std::min_element(std::begin(singleObj) + 1,
+                                         std::end(singleObj));
+        mIsFixed[std::distance(std::begin(singleObj), it)] = false;
+        --nbFixed;
+    }
+
+    mFixedVisitsBound = std::numeric_limits<double>::infinity();
+    for (int i = 1; i < n; ++i)
+    {
+        if (mIsFixed[i])
+        {
+            mFixedVisitsBound = std::min(mFixedVisitsBound, singleObj[i]);
+        }
+    }
+
+    std::vector<double> yUb(n, 1);
+    for (int i = 1; i < n; ++i)
+    {
+        yUb[i] = mIsFixed[i] ? 0 : 1;
+    }
+
+    std::vector<GRBVar> x;
+    std::vector<double> xUb;
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = i + 1; j < n; ++j)
+        {
+            if (utils::tools::varExists(m_x[i][j]))
+            {
+                x.push_back(m_x[i][j]);
+                xUb.push_back(mIsFixed[i] || mIsFixed[j] ? 0 :
+                              i == 0 ? 2 : 1);
+            }
+        }
+    }
+
+    setValues(m_y, yUb, GRB_DoubleAttr_UB);
+    setValues(x, xUb, GRB_DoubleAttr_UB);
+
+    DRAW_LOG_F(INFO, "PCTSP: %d customers fixed out", nbFixed);
 }
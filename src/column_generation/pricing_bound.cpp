@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: pricing_bound.cpp
+ *
+ * @brief Pricing lower bound functions definitions.
+ *
+ * Created on October 17, 2026, 08:20 PM
+ *
+ * References:
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <limits>
+
+#include "../../include/ext/loguru/loguru.hpp"
+
+#include "../../include/column_generation/pricing_bound.hpp"
+#include "../../include/instance.hpp"
+#include "../../include/utils/constants.hpp"
+
+/* ---------------------------- helper functions  --------------------------- */
+
+namespace
+{
+
+/**
+ * @brief Half of the two least cost edges of the vertex.
+ */
+double halfEdgesCost(const int i,
+                     const utils::Vec2D<double>& edgeDuals,
+                     const std::shared_ptr<const Instance>& pInst)
+{
+    double c1 = std::numeric_limits<double>::infinity();
+    double c2 = std::numeric_limits<double>::infinity();
+    for (int j = 0; j < pInst->getNbVertices(); ++j)
+    {
+        const double cost = pInst->getcij(i, j) - edgeDuals[i][j];
+        if (j == i)
+        {
+            continue;
+        }
+        else if (cost < c1)
+        {
+            c2 = c1;
+            c1 = cost;
+        }
+        else if (cost < c2)
+        {
+            c2 = cost;
+        }
+    }
+
+    // a route with a single customer uses the same depot edge twice
+    return i == 0 ? c1 : std::min((c1 + c2) / 2,
+                                  pInst->getcij(0, i) - edgeDuals[0][i]);
+}
+
+} // anonymous namespace
+
+/* -------------------------------------------------------------------------- */
+
+
+double pricingBound::knapsackBound(
+    const std::vector<double>& duals,
+    const utils::Vec2D<double>& edgeDuals,
+    const std::shared_ptr<const Instance>& pInst)
+{
+    const int n = pInst->getNbVertices();
+    DCHECK_F(static_cast<int>(duals.size()) == n + 1);
+
+    // profitable customers: prize minus half cost (the items of the knapsack)
+    std::vector<std::pair<double, double>> items; // (profit, demand)
+    for (int i = 1; i < n; ++i)
+    {
+        const double profit = duals[i] - halfEdgesCost(i, edgeDuals, pInst);
+        if (profit > utils::GRB_EPSILON && pInst->getdi(i) <= pInst->getC())
+        {
+            items.push_back({profit, pInst->getdi(i)});
+        }
+    }
+
+    // linear relaxation: the items by decreasing profit per unit of demand
+    std::sort(std::begin(items), std::end(items),
+        [](const auto& a, const auto& b)
+        {
+            return a.first * b.second > b.first * a.second;
+        });
+
+    double capacity = pInst->getC();
+    double maxProfit = 0;
+    for (const auto& [profit, demand] : items)
+    {
+        if (demand <= capacity)
+        {
+            maxProfit += profit;
+            capacity -= demand;
+        }
+        else
+        {
+            maxProfit += profit * capacity / demand;
+            break;
+        }
+    }
+
+    return halfEdgesCost(0, edgeDuals, pInst) - duals[0] - duals[n] -
+           maxProfit;
+}
@@ -0,0 +1,405 @@
+////////////////////////////////////////////////////////////////////////////////
+/*
+ * File: pricing_heuristic.cpp
+ *
+ * @brief Heuristic pricing functions definitions.
+ *
+ * Created on October 17, 2026, 10:20 AM
+ *
+ * References:
+ */
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <limits>
+#include <set>
+
+#include "../../include/ext/loguru/loguru.hpp"
+
+#include "../../include/column_generation/pricing_heuristic.hpp"
+#include "../../include/instance.hpp"
+#include "../../include/column_generation/column.hpp"
+#include "../../include/utils/constants.hpp"
+
+/* ---------------------------- helper functions  --------------------------- */
+
+namespace
+{
+
+// # of seed routes built per requested column
+const int cNbSeedsPerCol = 4;
+
+// maximum # of local search passes over a route
+const int cMaxNbLsPasses = 50;
+
+// maximum # of consecutive vertices moved by an Or-opt move
+const int cMaxOrOptLength = 3;
+
+
+/**
+ * @brief Removal of the tour vertex at position p (tour[p] != depot) if it
+ * saves more than its prize.
+ */
+bool dropMove(std::vector<int>& tour,
+              double& load,
+              std::vector<bool>& inRoute,
+              const std::vector<double>& duals,
+              const std::shared_ptr<const Instance>& pInst)
+{
+    if (tour.size() <= 2)
+    {
+        return false; // keep at least one customer in the route
+    }
+
+    const int m = tour.size();
+    for (int p = 1; p < m; ++p)
+    {
+        const int a = tour[p - 1];
+        const int v = tour[p];
+        const int b = tour[(p + 1) % m];
+        const double saving = pInst->getcij(a, v) + pInst->getcij(v, b) -
+                              pInst->getcij(a, b);
+
+        if (saving - duals[v] > utils::GRB_EPSILON)
+        {
+            load -= pInst->getdi(v);
+            inRoute[v] = false;
+            tour.erase(std::begin(tour) + p);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Insertion of the customer with least prize-aware insertion cost
+ * c_ai + c_ib - c_ab - pi_i (if negative and the capacity allows it).
+ */
+bool insertMove(std::vector<int>& tour,
+                double& load,
+                std::vector<bool>& inRoute,
+                const std::vector<int>& candidates,
+                const std::vector<double>& duals,
+                const std::shared_ptr<const Instance>& pInst)
+{
+    const int m = tour.size();
+    int bestVertex = -1;
+    int bestPos = -1;
+    double bestDelta = -utils::GRB_EPSILON;
+
+    for (int i : candidates)
+    {
+        if (inRoute[i] || load + pInst->getdi(i) > pInst->getC())
+        {
+            continue;
+        }
+
+        for (int p = 0; p < m; ++p)
+        {
+            const int a = tour[p];
+            const int b = tour[(p + 1) % m];
+            const double delta = pInst->getcij(a, i) + pInst->getcij(i, b) -
+                                 pInst->getcij(a, b) - duals[i];
+            if (delta < bestDelta)
+            {
+                bestDelta = delta;
+                bestVertex = i;
+                bestPos = p + 1;
+            }
+        }
+    }
+
+    if (bestVertex < 0)
+    {
+        return false;
+    }
+
+    load += pInst->getdi(bestVertex);
+    inRoute[bestVertex] = true;
+    tour.insert(std::begin(tour) + bestPos, bestVertex);
+
+    return true;
+}
+
+/**
+ * @brief First improvement 2-opt move.
+ */
+bool twoOptMove(std::vector<int>& tour,
+                const std::shared_ptr<const Instance>& pInst)
+{
+    const int m = tour.size();
+    for (int i = 0; i < m - 2; ++i)
+    {
+        for (int j = i + 2; j < m; ++j)
+        {
+            const int a = tour[i];
+            const int b = tour[i + 1];
+            const int c = tour[j];
+            const int d = tour[(j + 1) % m];
+            if (a == d)
+            {
+                continue;
+            }
+
+            const double delta = pInst->getcij(a, c) + pInst->getcij(b, d) -
+                                 pInst->getcij(a, b) - pInst->getcij(c, d);
+            if (delta < -utils::GRB_EPSILON)
+            {
+                std::reverse(std::begin(tour) + i + 1,
+                             std::begin(tour) + j + 1);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief First improvement Or-opt move: a segment of (at most
+ * cMaxOrOptLength) consecutive customers is moved, possibly reversed, to
+ * another position of the tour.
+ */
+bool orOptMove(std::vector<int>& tour,
+               const std::shared_ptr<const Instance>& pInst)
+{
+    const int m = tour.size();
+    for (int len = 1; len <= cMaxOrOptLength && len < m - 1; ++len)
+    {
+        for (int i = 1; i + len <= m; ++i)
+        {
+            const int prev = tour[i - 1];
+            const int first = tour[i];
+            const int last = tour[i + len - 1];
+            const int next = tour[(i + len) % m];
+            const double removal = pInst->getcij(prev, first) +
+                                   pInst->getcij(last, next) -
+                                   pInst->getcij(prev, next);
+
+            // insertion between tour[j] and tour[j + 1] (out of the segment)
+            for (int j = 0; j < m; ++j)
+            {
+                if (i - 1 <= j && j <= i + len - 1)
+                {
+                    continue;
+                }
+
+                const int a = tour[j];
+                const int b = tour[(j + 1) % m];
+                const double forward = pInst->getcij(a, first) +
+                    pInst->getcij(last, b) - pInst->getcij(a, b);
+                const double backward = pInst->getcij(a, last) +
+                    pInst->getcij(first, b) - pInst->getcij(a, b);
+
+                if (std::min(forward, backward) - removal < -utils::GRB_EPSILON)
+                {
+                    std::vector<int> segment(std::begin(tour) + i,
+                                             std::begin(tour) + i + len);
+                    if (backward < forward)
+                    {
+                        std::reverse(std::begin(segment), std::end(segment));
+                    }
+
+                    tour.erase(std::begin(tour) + i,
+                               std::begin(tour) + i + len);
+                    const int pos = j < i ? j + 1 : j - len + 1;
+                    tour.insert(std::begin(tour) + pos, std::begin(segment),
+                                std::end(segment));
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Builds a route from the given seed customer.
+ */
+std::vector<int> buildRoute(const int seed,
+                            const std::vector<int>& candidates,
+                            const std::vector<double>& duals,
+                            const std::shared_ptr<const Instance>& pInst)
+{
+    std::vector<int> tour{0, seed};
+    std::vector<bool> inRoute(pInst->getNbVertices(), false);
+    inRoute[0] = inRoute[seed] = true;
+    double load = pInst->getdi(seed);
+
+    // greedy construction
+    while (insertMove(tour, load, inRoute, candidates, duals, pInst));
+
+    // local search
+    bool improved = true;
+    for (int pass = 0; improved && pass < cMaxNbLsPasses; ++pass)
+    {
+        improved = twoOptMove(tour, pInst) ||
+                   dropMove(tour, load, inRoute, duals, pInst) ||
+                   insertMove(tour, load, inRoute, candidates, duals, pInst);
+    }
+
+    return tour;
+}
+
+} // anonymous namespace
+
+/* -------------------------------------------------------------------------- */
+
+
+std::vector<std::pair<Column, double>> pricingHeur::greedyInsertion(
+    const std::vector<double>& duals,
+    const int maxNbCols,
+    const std::shared_ptr<const Instance>& pInst)
+{
+    DCHECK_F(static_cast<int>(duals.size()) == pInst->getNbVertices() + 1);
+
+    // only customers with positive prizes can decrease the reduced cost
+    std::vector<int> candidates;
+    for (int i = 1; i < pInst->getNbVertices(); ++i)
+    {
+        if (duals[i] > utils::GRB_EPSILON && pInst->getdi(i) <= pInst->getC())
+        {
+            candidates.push_back(i);
+        }
+    }
+
+    // most promising seeds first: prize minus round trip cost
+    std::vector<int> seeds(candidates);
+    std::sort(std::begin(seeds), std::end(seeds),
+        [&duals, &pInst](const int i, const int j)
+        {
+            return duals[i] - 2 * pInst->getcij(0, i) >
+                   duals[j] - 2 * pInst->getcij(0, j);
+        });
+    seeds.resize(std::min(static_cast<int>(seeds.size()),
+                          cNbSeedsPerCol * maxNbCols));
+
+    std::vector<std::pair<Column, double>> columns;
+    std::set<std::vector<int>> built; // vertex sets of the routes built
+
+    for (int seed : seeds)
+    {
+        auto tour = buildRoute(seed, candidates, duals, pInst);
+
+        Column column(pInst);
+        for (int v : tour)
+        {
+            column.addVertex(v);
+        }
+        column.setCost(tourCost(tour, pInst));
+
+        const double rc = column.getReducedCost(duals);
+        if (rc >= -utils::GRB_EPSILON)
+        {
+            continue;
+        }
+
+        std::vector<int> vertices(tour);
+        std::sort(std::begin(vertices), std::end(vertices));
+        if (built.insert(vertices).second)
+        {
+            columns.push_back({column, rc});
+        }
+    }
+
+    std::sort(std::begin(columns), std::end(columns),
+        [](const auto& a, const auto& b) { return a.second < b.second; });
+    if (static_cast<int>(columns.size()) > maxNbCols)
+    {
+        columns.erase(std::begin(columns) + maxNbCols, std::end(columns));
+    }
+
+    return columns;
+}
+
+
+double pricingHeur::tourCost(const std::vector<int>& tour,
+                             const std::shared_ptr<const Instance>& pInst)
+{
+    double cost = 0;
+    for (std::size_t p = 0; p < tour.size(); ++p)
+    {
+        cost += pInst->getcij(tour[p], tour[(p + 1) % tour.size()]);
+    }
+    return cost;
+}
+
+
+std::vector<int> pricingHeur::buildTour(
+    const Column& column,
+    const std::shared_ptr<const Instance>& pInst)
+{
+    std::vector<int> tour{0};
+    for (int v : column)
+    {
+        if (v == 0)
+        {
+            continue;
+        }
+
+        int bestPos = 1;
+        double bestDelta = std::numeric_limits<double>::infinity();
+        for (std::size_t p = 0; p < tour.size(); ++p)
+        {
+            const int a = tour[p];
+            const int b = tour[(p + 1) % tour.size()];
+            const double delta = pInst->getcij(a, v) + pInst->getcij(v, b) -
+                                 pInst->getcij(a, b);
+            if (delta < bestDelta)
+            {
+                bestDelta = delta;
+                bestPos = p + 1;
+            }
+        }
+        tour.insert(std::begin(tour) + bestPos, v);
+    }
+
+    return tour;
+}
+
+
+double pricingHeur::improveRoute(Column& column,
+                                 const std::shared_ptr<const Instance>& pInst)
+{
+    DCHECK_F(column.contains(0));
+
+    // the sequence of the column (rotated to start at the depot)
+    std::vector<int> tour(std::begin(column), std::end(column));
+    std::rotate(std::begin(tour),
+                std::find(std::begin(tour), std::end(tour), 0),
+                std::end(tour));
+
+    // the sequence may not be a tour with the column cost (e.g., the vertices
+    // are in index order)
+    double cost = tourCost(tour, pInst);
+    if (cost > column.getCost() + utils::GRB_EPSILON)
+    {
+        auto insertionTour = buildTour(column, pInst);
+        const double insertionCost = tourCost(insertionTour, pInst);
+        if (insertionCost < cost)
+        {
+            tour.swap(insertionTour);
+            cost = insertionCost;
+        }
+    }
+
+    bool improved = true;
+    for (int pass = 0; improved && pass < cMaxNbLsPasses; ++pass)
+    {
+        improved = twoOptMove(tour, pInst) || orOptMove(tour, pInst);
+    }
+    cost = tourCost(tour, pInst);
+
+    if (cost > column.getCost() + utils::GRB_EPSILON)
+    {
+        return 0; // the sequence behind the column cost is unknown
+    }
+
+    const double newCost = std::min(cost, column.getCost());
+    const double decrease = column.getCost() - newCost;
+    column.setRoute(tour, newCost);
+
+    return decrease;
+}
@@ -13,10 +13,15 @@
  */
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+
 #include "../../include/ext/loguru/loguru.hpp"
 
 #include "../../include/column_generation/set_covering_lp.hpp"
 #include "../../include/instance.hpp"
+#include "../../include/column_generation/capacity_separation.hpp"
 #include "../../include/column_generation/init_grb_model.hpp"
 #include "../../include/column_generation/column.hpp"
 #include "../../include/utils/constants.hpp"
@@ -29,6 +34,9 @@ namespace
 
 const std::string cBaseName = "set_covering_";
 
+// least violation of a subset-row cut added to the model
+const double cMinSrViolation = 1e-2;
+
 }
 
 /* -------------------------------------------------------------------------- */
@@ -36,45 +44,103 @@ const std::string cBaseName = "set_covering_";
 
 SetCoveringLp::SetCoveringLp(const std::vector<Column>& columns,
                              const std::shared_ptr<const Instance>& pInst) :
-    BaseLp(pInst)
+    BaseLp(pInst),
+    mColumns(columns),
+    mAges(columns.size(), 0)
 {
     initModel(columns);
 }
 
 
-void SetCoveringLp::appendColumn(const Column& route)
+void SetCoveringLp::appendColumn(const Column& column)
 {
-    try
+    appendColumns(std::span<const Column>(&column, 1));
+}
+
+
+void SetCoveringLp::appendColumns(std::span<const Column> columns)
+{
+    if (columns.empty())
     {
-        const int j = m_y.size(); // column index of the new y variable
+        return;
+    }
 
-        // create new y variable
+    try
+    {
+        const int n = mpInst->getNbVertices();
+        const int nbCols = columns.size();
+
+        DCHECK_F(n < static_cast<int>(mConstrs.size()));
+
+        std::vector<double> lb(nbCols, 0);
+        std::vector<double> ub(nbCols, 1);
+        std::vector<double> obj(nbCols);
+        std::vector<char> type(nbCols, GRB_CONTINUOUS);
+        std::vector<std::string> names(nbCols);
+        std::vector<GRBColumn> cols(nbCols);
+
+        // sparse column data: cover constrs coefficients (first |V|
+        // constraints), k routes constraint coefficient (|V|th constraint),
+        // capacity cuts coefficients (# of edges crossing the cut) and
+        // subset-row cuts coefficients
+        std::vector<double> coeffs;
+        std::vector<GRBConstr> constrs;
+        for (int j = 0; j < nbCols; ++j)
         {
-            std::string name = "y_" + std::to_string(j);
-            double coeff = route.getCost();
-            m_y.push_back(mModel.addVar(0, 1, coeff, GRB_CONTINUOUS, name));
-        }
+            const auto& route = columns[j];
 
-        // add the new y's cover constrs coefficient (first |V| constraints)
-        for (int v : route)
-        {
-            DCHECK_F(v >= 0 && v < mpInst->getNbVertices());
-            DCHECK_F(v >= 0 && v < static_cast<int>(mConstrs.size()));
-            mModel.chgCoeff(mConstrs[v], m_y[j], 1);
+            obj[j] = route.getCost();
+            names[j] = "y_" + std::to_string(m_y.size() + j);
+
+            coeffs.assign(route.getNbVertices() + 1, 1);
+            constrs.clear();
+            for (int v : route)
+            {
+                DCHECK_F(v >= 0 && v < n);
+                constrs.push_back(mConstrs[v]);
+            }
+            constrs.push_back(mConstrs[n]);
+
+            for (std::size_t c = 0; c < mCapacityCuts.size(); ++c)
+            {
+                const int nbCrossings =
+                    route.getNbCrossings(mCapacityCuts[c].inSet_);
+                if (nbCrossings > 0)
+                {
+                    coeffs.push_back(nbCrossings);
+                    constrs.push_back(mConstrs[n + 1 + c]);
+                }
+            }
+
+            for (std::size_t s = 0; s < mSubsetRowCuts.size(); ++s)
+            {
+                if (route.getSubsetRowCoeff(mSubsetRowCuts[s]) > 0)
+                {
+                    coeffs.push_back(1);
+                    constrs.push_back(mSubsetRowConstrs[s]);
+                }
+            }
+
+            cols[j].addTerms(coeffs.data(), constrs.data(), constrs.size());
         }
 
-        // add the new y's k routes constraint (|V|th constraint)
-        DCHECK_F(mpInst->getNbVertices() < static_cast<int>(mConstrs.size()));
-        mModel.chgCoeff(mConstrs[mpInst->getNbVertices()], m_y[j], 1);
+        std::unique_ptr<GRBVar[]> y(mModel.addVars(lb.data(), ub.data(),
+            obj.data(), type.data(), names.data(), cols.data(), nbCols));
+        mModel.update();
+
+        m_y.insert(std::end(m_y), y.get(), y.get() + nbCols);
+        mColumns.insert(std::end(mColumns), std::begin(columns),
+                        std::end(columns));
+        mAges.resize(m_y.size(), 0);
     }
     catch (GRBException& e)
     {
-        RAW_LOG_F(FATAL, "SetCoveringLp::appendColumn(): C-Exp: %s",
+        RAW_LOG_F(FATAL, "SetCoveringLp::appendColumns(): C-Exp: %s",
             e.getMessage().c_str());
     }
     catch (...)
     {
-        RAW_LOG_F(FATAL, "SetCoveringLp::appendColumn(): Unknown Exception");
+        RAW_LOG_F(FATAL, "SetCoveringLp::appendColumns(): Unknown Exception");
     }
 }
 
@@ -85,27 +151,387 @@ int SetCoveringLp::getNbCols() const
 }
 
 
-double SetCoveringLp::getDual(const int i) const
+int SetCoveringLp::getNbInactiveCols() const
+{
+    return mInactiveColumns.size();
+}
+
+
+std::vector<Column> SetCoveringLp::getColumns() const
+{
+    std::vector<Column> columns(mColumns);
+    columns.insert(std::end(columns), std::begin(mInactiveColumns),
+                   std::end(mInactiveColumns));
+
+    return columns;
+}
+
+
+std::vector<std::pair<Column, double>> SetCoveringLp::getSolution()
+{
+    std::vector<std::pair<Column, double>> solution;
+
+    try
+    {
+        const auto y = getValues(m_y);
+        for (std::size_t j = 0; j < y.size(); ++j)
+        {
+            if (y[j] > utils::GRB_EPSILON)
+            {
+                solution.push_back({mColumns[j], y[j]});
+            }
+        }
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "SetCoveringLp::getSolution(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "SetCoveringLp::getSolution(): Unknown Exception");
+    }
+
+    return solution;
+}
+
+
+double SetCoveringLp::getArtificialVal() const
+{
+    double val = 0;
+
+    try
+    {
+        val = m_a.get(GRB_DoubleAttr_X);
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "SetCoveringLp::getArtificialVal(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL,
+            "SetCoveringLp::getArtificialVal(): Unknown Exception");
+    }
+
+    return val;
+}
+
+
+std::vector<double> SetCoveringLp::getDuals()
+{
+    std::vector<double> duals;
+
+    try
+    {
+        duals = BaseLp::getDuals(mConstrs);
+        const auto srDuals = BaseLp::getDuals(mSubsetRowConstrs);
+        duals.insert(std::end(duals), std::begin(srDuals), std::end(srDuals));
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "SetCoveringLp::getDuals(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "SetCoveringLp::getDuals(): Unknown Exception");
+    }
+
+    return duals;
+}
+
+
+double SetCoveringLp::getReducedCost(const Column& column,
+                                     const std::vector<double>& duals) const
+{
+    const int n = mpInst->getNbVertices();
+    const int nbCapCuts = mCapacityCuts.size();
+    DCHECK_F(static_cast<int>(duals.size()) == n + 1 + nbCapCuts +
+             static_cast<int>(mSubsetRowCuts.size()));
+
+    std::vector<double> routeDuals(std::begin(duals),
+                                   std::begin(duals) + n + 1);
+    double rc = column.getReducedCost(routeDuals);
+    for (int c = 0; c < nbCapCuts; ++c)
+    {
+        rc -= duals[n + 1 + c] *
+              column.getNbCrossings(mCapacityCuts[c].inSet_);
+    }
+
+    for (std::size_t s = 0; s < mSubsetRowCuts.size(); ++s)
+    {
+        rc -= duals[n + 1 + nbCapCuts + s] *
+              column.getSubsetRowCoeff(mSubsetRowCuts[s]);
+    }
+
+    return rc;
+}
+
+
+utils::Vec2D<double> SetCoveringLp::getEdgeDuals(
+    const std::vector<double>& duals) const
+{
+    const int n = mpInst->getNbVertices();
+    DCHECK_F(static_cast<int>(duals.size()) == n + 1 +
+             static_cast<int>(mCapacityCuts.size() + mSubsetRowCuts.size()));
+
+    utils::Vec2D<double> edgeDuals(n, std::vector<double>(n, 0));
+    for (std::size_t c = 0; c < mCapacityCuts.size(); ++c)
+    {
+        const double mu = duals[n + 1 + c];
+        if (mu <= 0)
+        {
+            continue;
+        }
+
+        const auto& inSet = mCapacityCuts[c].inSet_;
+        for (int i : mCapacityCuts[c].set_)
+        {
+            for (int j = 0; j < n; ++j)
+            {
+                if (!inSet[j])
+                {
+                    edgeDuals[i][j] += mu;
+                    edgeDuals[j][i] += mu;
+                }
+            }
+        }
+    }
+
+    return edgeDuals;
+}
+
+
+const std::vector<SetCoveringLp::CapacityCut>&
+    SetCoveringLp::getCapacityCuts() const
+{
+    return mCapacityCuts;
+}
+
+
+std::vector<SubsetRowCut> SetCoveringLp::getSubsetRowDuals(
+    const std::vector<double>& duals) const
+{
+    const int first = mpInst->getNbVertices() + 1 + mCapacityCuts.size();
+    DCHECK_F(static_cast<int>(duals.size()) ==
+             first + static_cast<int>(mSubsetRowCuts.size()));
+
+    std::vector<SubsetRowCut> cuts;
+    for (std::size_t s = 0; s < mSubsetRowCuts.size(); ++s)
+    {
+        if (duals[first + s] < -utils::GRB_EPSILON)
+        {
+            cuts.push_back({mSubsetRowCuts[s], duals[first + s]});
+        }
+    }
+
+    return cuts;
+}
+
+
+const std::vector<std::array<int, 3>>&
+    SetCoveringLp::getSubsetRowCuts() const
 {
-    DCHECK_F(i >= 0 && i < static_cast<int>(mConstrs.size()));
+    return mSubsetRowCuts;
+}
+
 
-    double pi = 0;
+int SetCoveringLp::addCapacityCuts(const int maxNbCuts)
+{
+    const int n = mpInst->getNbVertices();
+    int nbAdded = 0;
 
     try
     {
-        pi = mConstrs[i].get(GRB_DoubleAttr_Pi);
+        // edge values of the last solution
+        utils::Vec2D<double> xVal(n, std::vector<double>(n, 0));
+        for (const auto& [column, val] : getSolution())
+        {
+            std::vector<int> route(std::begin(column), std::end(column));
+            for (std::size_t p = 0; p < route.size(); ++p)
+            {
+                const int a = route[p];
+                const int b = route[(p + 1) % route.size()];
+                xVal[std::min(a, b)][std::max(a, b)] += val;
+            }
+        }
+
+        for (auto& set : capSep::separateCapacityCuts(xVal, maxNbCuts, mpInst))
+        {
+            if (!mCapacityCutSets.insert(set).second)
+            {
+                continue;
+            }
+
+            const double rhs = 2.0 * capSep::getMinNbVehicles(set, mpInst);
+            CapacityCut cut{std::move(set), std::vector<bool>(n, false), rhs};
+            for (int i : cut.set_)
+            {
+                cut.inSet_[i] = true;
+            }
+
+            GRBLinExpr lhs = cut.rhs_ * m_a;
+            for (std::size_t j = 0; j < m_y.size(); ++j)
+            {
+                const int nbCrossings = mColumns[j].getNbCrossings(cut.inSet_);
+                if (nbCrossings > 0)
+                {
+                    lhs += nbCrossings * m_y[j];
+                }
+            }
+
+            std::ostringstream oss;
+            oss << "RCC_" << mCapacityCuts.size();
+            mConstrs.push_back(mModel.addConstr(lhs >= cut.rhs_, oss.str()));
+            mCapacityCuts.push_back(std::move(cut));
+            ++nbAdded;
+        }
+
+        if (nbAdded > 0)
+        {
+            mModel.update();
+        }
     }
     catch (GRBException& e)
     {
-        RAW_LOG_F(FATAL, "SetCoveringLp::getDual(): C-Exp: %s",
+        RAW_LOG_F(FATAL, "SetCoveringLp::addCapacityCuts(): C-Exp: %s",
             e.getMessage().c_str());
     }
     catch (...)
     {
-        RAW_LOG_F(FATAL, "SetCoveringLp::getDual(): Unknown Exception");
+        RAW_LOG_F(FATAL, "SetCoveringLp::addCapacityCuts(): Unknown Exception");
     }
 
-    return pi;
+    return nbAdded;
+}
+
+
+int SetCoveringLp::addSubsetRowCuts(const int maxNbCuts)
+{
+    const int n = mpInst->getNbVertices();
+    int nbAdded = 0;
+
+    try
+    {
+        const auto solution = getSolution();
+
+        // value of the routes visiting each pair of customers and the
+        // customers of the fractional routes (only their triples may be
+        // violated)
+        utils::Vec2D<double> pairVal(n, std::vector<double>(n, 0));
+        std::vector<bool> isCandidate(n, false);
+        for (const auto& [column, val] : solution)
+        {
+            std::vector<int> customers;
+            for (int i = 1; i < n; ++i)
+            {
+                if (column.contains(i))
+                {
+                    customers.push_back(i);
+                    isCandidate[i] = isCandidate[i] ||
+                                     val < 1 - utils::GRB_EPSILON;
+                }
+            }
+
+            for (std::size_t p = 0; p < customers.size(); ++p)
+            {
+                for (std::size_t q = p + 1; q < customers.size(); ++q)
+                {
+                    pairVal[customers[p]][customers[q]] += val;
+                }
+            }
+        }
+
+        std::vector<int> candidates;
+        for (int i = 1; i < n; ++i)
+        {
+            if (isCandidate[i])
+            {
+                candidates.push_back(i);
+            }
+        }
+
+        // the sum of the pairs values bounds the left-hand side of the cut
+        std::vector<std::pair<double, std::array<int, 3>>> violated;
+        const int m = candidates.size();
+        for (int p = 0; p < m; ++p)
+        {
+            const int a = candidates[p];
+            for (int q = p + 1; q < m; ++q)
+            {
+                const int b = candidates[q];
+                for (int r = q + 1; r < m; ++r)
+                {
+                    const int c = candidates[r];
+                    if (pairVal[a][b] + pairVal[a][c] + pairVal[b][c] <=
+                        1 + cMinSrViolation)
+                    {
+                        continue;
+                    }
+
+                    const std::array<int, 3> set{a, b, c};
+                    double lhs = 0;
+                    for (const auto& [column, val] : solution)
+                    {
+                        lhs += val * column.getSubsetRowCoeff(set);
+                    }
+
+                    if (lhs > 1 + cMinSrViolation &&
+                        std::find(std::begin(mSubsetRowCuts),
+                                  std::end(mSubsetRowCuts), set) ==
+                            std::end(mSubsetRowCuts))
+                    {
+                        violated.push_back({lhs, set});
+                    }
+                }
+            }
+        }
+
+        // most violated first
+        std::sort(std::begin(violated), std::end(violated),
+            [](const auto& x, const auto& y) { return x.first > y.first; });
+        if (static_cast<int>(violated.size()) > maxNbCuts)
+        {
+            violated.resize(maxNbCuts);
+        }
+
+        for (const auto& [lhsVal, set] : violated)
+        {
+            GRBLinExpr lhs = 0;
+            for (std::size_t j = 0; j < m_y.size(); ++j)
+            {
+                if (mColumns[j].getSubsetRowCoeff(set) > 0)
+                {
+                    lhs += m_y[j];
+                }
+            }
+
+            std::ostringstream oss;
+            oss << "SR_" << set[0] << "_" << set[1] << "_" << set[2];
+            mSubsetRowConstrs.push_back(mModel.addConstr(lhs <= 1, oss.str()));
+            mSubsetRowCuts.push_back(set);
+            ++nbAdded;
+        }
+
+        if (nbAdded > 0)
+        {
+            mModel.update();
+        }
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "SetCoveringLp::addSubsetRowCuts(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL,
+            "SetCoveringLp::addSubsetRowCuts(): Unknown Exception");
+    }
+
+    return nbAdded;
 }
 
 
@@ -133,20 +559,15 @@ void SetCoveringLp::imposeIntegrality()
 }
 
 
-bool SetCoveringLp::isSolutionInteger() const
+bool SetCoveringLp::isSolutionInteger()
 {
     int nbSolCols = 0;
 
     try
     {
-        for (int i = 0; i < static_cast<int>(m_y.size()); ++i)
-        {
-            if (utils::tools::varExists(m_y[i]) &&
-                m_y[i].get(GRB_DoubleAttr_X) > utils::GRB_EPSILON)
-            {
-                ++nbSolCols;
-            }
-        }
+        const auto y = getValues(m_y);
+        nbSolCols = std::count_if(std::begin(y), std::end(y),
+            [](const double val) { return val > utils::GRB_EPSILON; });
     }
     catch (GRBException& e)
     {
@@ -162,6 +583,91 @@ bool SetCoveringLp::isSolutionInteger() const
     return nbSolCols == mpInst->getK();
 }
 
+
+int SetCoveringLp::purgeColumns(const int maxAge)
+{
+    DCHECK_F(m_y.size() == mColumns.size() && m_y.size() == mAges.size());
+
+    int nbPurged = 0;
+
+    try
+    {
+        const auto vBasis = getValues(m_y, GRB_IntAttr_VBasis);
+        const auto rc = getValues(m_y, GRB_DoubleAttr_RC);
+
+        std::size_t k = 0; // # of columns kept in the model
+        for (std::size_t j = 0; j < m_y.size(); ++j)
+        {
+            if (vBasis[j] == GRB_BASIC || rc[j] < utils::GRB_EPSILON)
+            {
+                mAges[j] = 0;
+            }
+            else
+            {
+                ++mAges[j];
+            }
+
+            if (mAges[j] > maxAge)
+            {
+                mModel.remove(m_y[j]);
+                mInactiveColumns.push_back(std::move(mColumns[j]));
+                ++nbPurged;
+                continue;
+            }
+
+            if (k != j)
+            {
+                m_y[k] = m_y[j];
+                mColumns[k] = std::move(mColumns[j]);
+                mAges[k] = mAges[j];
+            }
+            ++k;
+        }
+
+        m_y.resize(k);
+        mColumns.resize(k);
+        mAges.resize(k);
+    }
+    catch (GRBException& e)
+    {
+        RAW_LOG_F(FATAL, "SetCoveringLp::purgeColumns(): C-Exp: %s",
+            e.getMessage().c_str());
+    }
+    catch (...)
+    {
+        RAW_LOG_F(FATAL, "SetCoveringLp::purgeColumns(): Unknown Exception");
+    }
+
+    return nbPurged;
+}
+
+
+int SetCoveringLp::reactivateColumns(const std::vector<double>& duals)
+{
+    auto it = std::partition(std::begin(mInactiveColumns),
+                             std::end(mInactiveColumns),
+        [this, &duals](const Column& column)
+        {
+            return getReducedCost(column, duals) >= -utils::GRB_EPSILON;
+        });
+
+    std::vector<Column> columns(std::make_move_iterator(it),
+                                std::make_move_iterator(
+                                    std::end(mInactiveColumns)));
+    mInactiveColumns.erase(it, std::end(mInactiveColumns));
+
+    appendColumns(columns);
+
+    return columns.size();
+}
+
+
+void SetCoveringLp::restoreInactiveColumns()
+{
+    appendColumns(mInactiveColumns);
+    mInactiveColumns.clear();
+}
+
 /* ----------------------------- private methods ---------------------------- */
 
 void SetCoveringLp::initModel(const std::vector<Column>& columns)
@@ -180,6 +686,24 @@ void SetCoveringLp::initModel(const std::vector<Column>& columns)
         init::coveringConstrs(mModel, mConstrs, m_y, columns, mpInst);
         init::kRoutesConstr(mModel, mConstrs, m_y, columns, mpInst);
 
+        // artificial variable: each unit covers every vertex as one route and
+        // costs more than any solution (every route costs at most the sum of
+        // the round trips to its customers)
+        {
+            double cost = 0;
+            for (int i = 1; i < mpInst->getNbVertices(); ++i)
+            {
+                cost += 2 * mpInst->getcij(0, i);
+            }
+            cost *= mpInst->getNbVertices();
+
+            GRBColumn column;
+            std::vector<double> coeffs(mConstrs.size(), 1);
+            column.addTerms(coeffs.data(), mConstrs.data(), mConstrs.size());
+            m_a = mModel.addVar(0, GRB_INFINITY, cost, GRB_CONTINUOUS, column,
+                                "a");
+        }
+
         mModel.update();
     }
     catch (GRBException& e)
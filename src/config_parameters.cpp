@@ -36,6 +36,38 @@ const std::string c_K = "nb_vehicles";
 const std::string cInitPoolSize = "cg_initial_pool_size";
 const std::string cMaxIter = "cg_max_iter";
 const std::string cTimeLimit = "cg_time_limit";
+const std::string cMaxNbColsPerIter = "cg_max_nb_cols_per_iter";
+const std::string cColMaxAge = "cg_col_max_age";
+const std::string cPricingHeuristic = "cg_pricing_heuristic";
+const std::string cPricingEngine = "cg_pricing_engine";
+const std::string cNbPricingWorkers = "cg_nb_pricing_workers";
+const std::string cNgSize = "cg_ng_size";
+const std::string cEarlyExitPricing = "cg_early_exit_pricing";
+const std::string cEarlyExitRc = "cg_early_exit_rc";
+const std::string cNbNearestEdges = "cg_nb_nearest_edges";
+const std::string cCutPoolSize = "cg_cut_pool_size";
+const std::string cNbCutRounds = "cg_nb_cut_rounds";
+const std::string cMaxNbSrCuts = "cg_max_nb_sr_cuts";
+const std::string cSepCompMaxCuts = "cg_sep_comp_max_cuts";
+const std::string cSepCompMinViolation = "cg_sep_comp_min_violation";
+const std::string cSepCapMaxCuts = "cg_sep_cap_max_cuts";
+const std::string cSepCapMinViolation = "cg_sep_cap_min_violation";
+const std::string cSepMinCutMaxCuts = "cg_sep_mincut_max_cuts";
+const std::string cSepMinCutMinViolation = "cg_sep_mincut_min_violation";
+const std::string cSepSecsPerSet = "cg_sep_secs_per_set";
+const std::string cSepMaxCutsPerRound = "cg_sep_max_cuts_per_round";
+const std::string cSepMaxCutsPerNode = "cg_sep_max_cuts_per_node";
+const std::string cSepTreeMinViolation = "cg_sep_tree_min_violation";
+const std::string cSepNodePolicy = "cg_sep_node_policy";
+const std::string cSepNodeInterval = "cg_sep_node_interval";
+const std::string cSepMaxNodes = "cg_sep_max_nodes";
+const std::string cSepTailingOffRounds = "cg_sep_tailing_off_rounds";
+const std::string cSepTailingOffGain = "cg_sep_tailing_off_gain";
+const std::string cStabilization = "cg_stabilization";
+const std::string cSmoothingAlpha = "cg_smoothing_alpha";
+const std::string cGapTolerance = "cg_gap_tolerance";
+const std::string cBpNbThreads = "bp_nb_threads";
+const std::string cBpTimeLimit = "bp_time_limit";
 const std::string c_solver_show_log = "solver_show_log";
 const std::string c_solver_time_limit = "solver_time_limit";
 const std::string c_solver_nb_threads = "solver_nb_threads";
@@ -69,6 +101,97 @@ int parseUint(const std::string &str)
     return static_cast<std::size_t>(val);
 }
 
+/**
+ * @brief Parse string to a non-negative double.
+ * @param: const std::string &: string to be parsed.
+ * @return: double: parsed value.
+*/
+double parseDouble(const std::string &str)
+{
+    double val = std::stod(str);
+    CHECK_F(val >= 0, "Input parameter: Invalid value");
+
+    return val;
+}
+
+/**
+ * @brief Parse the smoothing factor of the dual stabilization. The value 'auto'
+ * is parsed to -1 (automatic smoothing factor).
+ * @param: const std::string &: string to be parsed.
+ * @return: double: parsed value.
+*/
+double parseSmoothingAlpha(const std::string &str)
+{
+    if (str == "auto")
+    {
+        return -1;
+    }
+
+    double val = std::stod(str);
+    CHECK_F(val >= 0 && val < 1, "Input parameter: Invalid value");
+
+    return val;
+}
+
+/**
+ * @brief Parse the dual stabilization technique.
+ * @param: const std::string &: string to be parsed.
+ * @return: ConfigParameters::cg::stabilization: parsed value.
+*/
+ConfigParameters::cg::stabilization parseStabilization(const std::string &str)
+{
+    if (str == "wentges")
+    {
+        return ConfigParameters::cg::stabilization::wentges;
+    }
+
+    CHECK_F(str == "none", "Input parameter: Invalid value");
+
+    return ConfigParameters::cg::stabilization::none;
+}
+
+/**
+ * @brief Parse the exact pricing engine.
+ * @param: const std::string &: string to be parsed.
+ * @return: ConfigParameters::cg::pricingEngine: parsed value.
+*/
+ConfigParameters::cg::pricingEngine parsePricingEngine(const std::string &str)
+{
+    if (str == "labeling")
+    {
+        return ConfigParameters::cg::pricingEngine::labeling;
+    }
+
+    CHECK_F(str == "pctsp", "Input parameter: Invalid value");
+
+    return ConfigParameters::cg::pricingEngine::pctsp;
+}
+
+/**
+ * @brief Parse the policy of the B&B nodes where the SECs are separated.
+ * @param: const std::string &: string to be parsed.
+ * @return: ConfigParameters::cg::sepNodePolicy: parsed value.
+*/
+ConfigParameters::cg::sepNodePolicy parseSepNodePolicy(const std::string &str)
+{
+    if (str == "root")
+    {
+        return ConfigParameters::cg::sepNodePolicy::root;
+    }
+    else if (str == "interval")
+    {
+        return ConfigParameters::cg::sepNodePolicy::interval;
+    }
+    else if (str == "first")
+    {
+        return ConfigParameters::cg::sepNodePolicy::first;
+    }
+
+    CHECK_F(str == "all", "Input parameter: Invalid value");
+
+    return ConfigParameters::cg::sepNodePolicy::all;
+}
+
 /**
  * @brief Parse string to unsigned int. It also checks if the input string is
  * set to max. If so, then parse to max value.
@@ -167,6 +290,12 @@ const ConfigParameters::cg& ConfigParameters::getCgParams() const
 }
 
 
+const ConfigParameters::bp& ConfigParameters::getBpParams() const
+{
+    return mBpParam;
+}
+
+
 const ConfigParameters::model& ConfigParameters::getModelParams() const
 {
     return mModelParam;
@@ -210,6 +339,49 @@ void ConfigParameters::setupParameters()
     mCgParam.initPoolSize_ = parseUint(mData[cInitPoolSize]);
     mCgParam.maxIter_ = parseUint(mData[cMaxIter]);
     mCgParam.timeLimit_ = parseUint(mData[cTimeLimit]);
+    mCgParam.maxNbColsPerIter_ = parseUint(mData[cMaxNbColsPerIter]);
+    CHECK_F(mCgParam.maxNbColsPerIter_ > 0,
+        "Input parameter: %s must be positive", cMaxNbColsPerIter.c_str());
+    mCgParam.colMaxAge_ = parseUint(mData[cColMaxAge]);
+    mCgParam.pricingHeuristic_ = parseBool(mData[cPricingHeuristic]);
+    mCgParam.pricingEngine_ = parsePricingEngine(mData[cPricingEngine]);
+    mCgParam.nbPricingWorkers_ = parseNbThreads(mData[cNbPricingWorkers]);
+    CHECK_F(mCgParam.nbPricingWorkers_ > 0,
+        "Input parameter: %s must be positive", cNbPricingWorkers.c_str());
+    mCgParam.ngSize_ = parseUint(mData[cNgSize]);
+    mCgParam.earlyExitPricing_ = parseBool(mData[cEarlyExitPricing]);
+    mCgParam.earlyExitRc_ = parseDouble(mData[cEarlyExitRc]);
+    mCgParam.nbNearestEdges_ = parseUint(mData[cNbNearestEdges]);
+    mCgParam.cutPoolSize_ = parseUint(mData[cCutPoolSize]);
+    mCgParam.nbCutRounds_ = parseUint(mData[cNbCutRounds]);
+    mCgParam.maxNbSrCuts_ = parseUint(mData[cMaxNbSrCuts]);
+    mCgParam.sepCompMaxCuts_ = parseUint(mData[cSepCompMaxCuts]);
+    mCgParam.sepCompMinViolation_ = parseDouble(mData[cSepCompMinViolation]);
+    mCgParam.sepCapMaxCuts_ = parseUint(mData[cSepCapMaxCuts]);
+    mCgParam.sepCapMinViolation_ = parseDouble(mData[cSepCapMinViolation]);
+    mCgParam.sepMinCutMaxCuts_ = parseUint(mData[cSepMinCutMaxCuts]);
+    mCgParam.sepMinCutMinViolation_ =
+        parseDouble(mData[cSepMinCutMinViolation]);
+    mCgParam.sepSecsPerSet_ = parseUint(mData[cSepSecsPerSet]);
+    mCgParam.sepMaxCutsPerRound_ = parseUint(mData[cSepMaxCutsPerRound]);
+    mCgParam.sepMaxCutsPerNode_ = parseUint(mData[cSepMaxCutsPerNode]);
+    mCgParam.sepTreeMinViolation_ = parseDouble(mData[cSepTreeMinViolation]);
+    mCgParam.sepNodePolicy_ = parseSepNodePolicy(mData[cSepNodePolicy]);
+    mCgParam.sepNodeInterval_ = parseUint(mData[cSepNodeInterval]);
+    CHECK_F(mCgParam.sepNodeInterval_ > 0,
+        "Input parameter: %s must be positive", cSepNodeInterval.c_str());
+    mCgParam.sepMaxNodes_ = parseUint(mData[cSepMaxNodes]);
+    mCgParam.sepTailingOffRounds_ = parseUint(mData[cSepTailingOffRounds]);
+    mCgParam.sepTailingOffGain_ = parseDouble(mData[cSepTailingOffGain]);
+    mCgParam.stabilization_ = parseStabilization(mData[cStabilization]);
+    mCgParam.smoothingAlpha_ = parseSmoothingAlpha(mData[cSmoothingAlpha]);
+    mCgParam.gapTolerance_ = parseDouble(mData[cGapTolerance]);
+
+    // ---- B&P parameters ----
+    mBpParam.nbThreads_ = parseNbThreads(mData[cBpNbThreads]);
+    CHECK_F(mBpParam.nbThreads_ > 0,
+        "Input parameter: %s must be positive", cBpNbThreads.c_str());
+    mBpParam.timeLimit_ = parseUint(mData[cBpTimeLimit]);
 
     // ---- Model parameters ----
     mModelParam.K_ = std::stoi(mData[c_K]);
@@ -22,7 +22,7 @@
 
 #include "../include/config_parameters.hpp"
 #include "../include/instance.hpp"
-#include "../include/column_generation/cg.hpp"
+#include "../include/column_generation/branch_and_price.hpp"
 #include "../include/column_generation/column.hpp"
 #include "../include/column_generation/init_pool.hpp"
 #include "../include/utils/helper.hpp"
@@ -38,8 +38,9 @@ void buildNsolve(const std::string& path,
 
     auto columns = initPool::randomCovers(50, pInst);
 
-    Cg cg(params.getCgParams(), columns, pInst);
-    cg.execute(params.getSolverParams());
+    BranchAndPrice bp(params.getCgParams(), params.getBpParams(), columns,
+                      pInst);
+    bp.execute(params.getSolverParams());
 }
 
 
@@ -91,3 +91,16 @@ bool utils::tools::varExists(const GRBVar& var)
     /* see [1] */
     return var.index() != -2 && var.index() != -1;
 }
+
+
+std::size_t utils::tools::VectorHash::operator()(
+    const std::vector<int>& v) const
+{
+    std::size_t seed = v.size();
+    for (int i : v)
+    {
+        seed ^= std::hash<int>{}(i) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    return seed;
+}